@@ -0,0 +1,183 @@
+// Copyright 2025 Siddhant Biradar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Microbenchmarks for the hot paths: extraction, graph construction,
+// traversal and index save/load. Build with -DPIONEER_BUILD_BENCHMARKS=ON
+// and run ./pioneer_bench; fixtures are synthesized so results do not
+// depend on any checked-out source tree.
+
+#include "pioneer/graph.hpp"
+#include "pioneer/parser.hpp"
+#include "pioneer/query.hpp"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <string>
+
+using namespace pioneer;
+
+namespace {
+
+// Synthetic translation unit with `count` functions, each calling its
+// predecessor, so call and variable extraction have real work to do
+std::string make_source(Language lang, int count) {
+    std::string src;
+    for (int i = 0; i < count; ++i) {
+        std::string name = "func_" + std::to_string(i);
+        std::string prev = "func_" + std::to_string(i > 0 ? i - 1 : 0);
+        switch (lang) {
+        case Language::Python:
+            src += "def " + name + "(a, b):\n";
+            src += "    x = " + prev + "(a, b)\n";
+            src += "    return x + 1\n\n";
+            break;
+        case Language::C:
+            src += "int " + name + "(int a, int b) {\n";
+            src += "    int x = " + prev + "(a, b);\n";
+            src += "    return x + 1;\n}\n\n";
+            break;
+        case Language::Cpp:
+            src += "int " + name + "(int a, int b) {\n";
+            src += "    int x = demo::" + prev + "(a, b);\n";
+            src += "    return x + 1;\n}\n\n";
+            break;
+        default:
+            break;
+        }
+    }
+    return src;
+}
+
+void bench_extract_functions(benchmark::State &state, Language lang) {
+    std::string src = make_source(lang, 100);
+    auto parser = create_parser(lang);
+
+    for (auto _ : state) {
+        parser->parse(src.data(), src.size());
+        auto functions = parser->extract_functions();
+        benchmark::DoNotOptimize(functions);
+    }
+    state.SetItemsProcessed(state.iterations() * 100);
+}
+
+void BM_ExtractFunctions_Python(benchmark::State &state) {
+    bench_extract_functions(state, Language::Python);
+}
+
+void BM_ExtractFunctions_C(benchmark::State &state) { bench_extract_functions(state, Language::C); }
+
+void BM_ExtractFunctions_Cpp(benchmark::State &state) {
+    bench_extract_functions(state, Language::Cpp);
+}
+
+// Symbol interning, edge insertion and the CSR pack that finalize() runs
+void BM_CallGraphBuildFinalize(benchmark::State &state) {
+    const int symbols = static_cast<int>(state.range(0));
+
+    std::vector<std::string> names;
+    names.reserve(symbols);
+    for (int i = 0; i < symbols; ++i) {
+        names.push_back("sym_" + std::to_string(i));
+    }
+
+    for (auto _ : state) {
+        Graph graph;
+        for (int i = 0; i < symbols; ++i) {
+            graph.add_symbol(names[i]);
+        }
+        for (int i = 1; i < symbols; ++i) {
+            graph.add_call(names[i / 2], names[i]); // Binary-tree shape
+            graph.add_call(names[i - 1], names[i]); // Plus a long chain
+        }
+        graph.finalize();
+        benchmark::DoNotOptimize(graph);
+    }
+    state.SetItemsProcessed(state.iterations() * symbols);
+}
+
+// Complete tree with the given fan-out; one path per leaf, so this measures
+// raw enumeration throughput at different branching factors
+Graph make_tree_graph(int fanout, int total_nodes) {
+    Graph graph;
+    graph.add_symbol("node_0");
+    for (int i = 1; i < total_nodes; ++i) {
+        std::string child = "node_" + std::to_string(i);
+        std::string parent = "node_" + std::to_string((i - 1) / fanout);
+        graph.add_symbol(child);
+        graph.add_call(parent, child);
+    }
+    graph.finalize();
+    return graph;
+}
+
+void BM_ForwardTrace(benchmark::State &state) {
+    const int fanout = static_cast<int>(state.range(0));
+    Graph graph = make_tree_graph(fanout, 4096);
+    QueryEngine engine(graph);
+
+    for (auto _ : state) {
+        size_t paths = 0;
+        engine.forward_trace("node_0", UidPathCallback([&](std::span<const SymbolUID>) {
+                                 paths++;
+                                 return true;
+                             }));
+        benchmark::DoNotOptimize(paths);
+    }
+}
+
+Graph make_save_load_graph() {
+    Graph graph;
+    const int symbols = 10000;
+    for (int i = 0; i < symbols; ++i) {
+        graph.add_symbol("sym_" + std::to_string(i), "src/file_" + std::to_string(i % 100) + ".py");
+    }
+    for (int i = 1; i < symbols; ++i) {
+        graph.add_call("sym_" + std::to_string(i / 3), "sym_" + std::to_string(i));
+    }
+    graph.finalize();
+    return graph;
+}
+
+void BM_GraphSave(benchmark::State &state) {
+    Graph graph = make_save_load_graph();
+    std::string path = (std::filesystem::temp_directory_path() / "pioneer_bench.json").string();
+
+    for (auto _ : state) {
+        graph.save(path);
+    }
+    std::filesystem::remove(path);
+}
+
+void BM_GraphLoad(benchmark::State &state) {
+    Graph graph = make_save_load_graph();
+    std::string path = (std::filesystem::temp_directory_path() / "pioneer_bench.json").string();
+    graph.save(path);
+
+    for (auto _ : state) {
+        Graph loaded = Graph::load(path);
+        benchmark::DoNotOptimize(loaded);
+    }
+    std::filesystem::remove(path);
+}
+
+BENCHMARK(BM_ExtractFunctions_Python);
+BENCHMARK(BM_ExtractFunctions_C);
+BENCHMARK(BM_ExtractFunctions_Cpp);
+BENCHMARK(BM_CallGraphBuildFinalize)->Arg(1000)->Arg(10000);
+BENCHMARK(BM_ForwardTrace)->Arg(2)->Arg(8)->Arg(32);
+BENCHMARK(BM_GraphSave);
+BENCHMARK(BM_GraphLoad);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,149 @@
+// Copyright 2025 Siddhant Biradar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "graph.hpp"
+#include "types.hpp"
+#include <cstdint>
+#include <string>
+
+namespace pioneer {
+
+// Binary index format (.pioneer.idx)
+//
+// All sections are fixed-width little-endian records so the file can be
+// memory-mapped and binary-searched in place - no parsing pass is needed
+// before answering the first query. Layout:
+//
+//   BinaryIndexHeader
+//   SectionEntry[section_count]
+//   ...section payloads...
+//
+// Symbol and file-path names live in string pool sections referenced by
+// (offset, length) pairs. Adjacency sections (call map, data flow, ...)
+// store sorted AdjacencyRecord keys followed by a packed uint64 target
+// array within the same section.
+
+constexpr char BINARY_INDEX_MAGIC[8] = {'P', 'I', 'O', 'N', 'I', 'D', 'X', '\0'};
+constexpr uint32_t BINARY_INDEX_VERSION = 1;
+
+enum class SectionId : uint32_t {
+    SymbolTable = 0,
+    SymbolPool = 1,
+    CallMap = 2,
+    ReverseCallMap = 3,
+    DataFlowMap = 4,
+    ReverseDataFlowMap = 5,
+    FilePathTable = 6,
+    FilePathPool = 7,
+    FileSymbols = 8,
+    SymbolFiles = 9,
+    FileMeta = 10,
+};
+
+struct BinaryIndexHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t section_count;
+    uint64_t end_uid;
+    uint64_t next_uid;
+    uint64_t next_file_uid;
+};
+
+struct SectionEntry {
+    uint32_t id;
+    uint32_t reserved;
+    uint64_t offset; // Byte offset from start of file
+    uint64_t size;   // Section payload size in bytes
+    uint64_t count;  // Number of records (section-specific meaning)
+};
+
+struct SymbolRecord {
+    uint64_t uid;
+    uint64_t name_offset; // Into SymbolPool
+    uint32_t name_len;
+    uint32_t type; // SymbolType
+};
+
+struct AdjacencyRecord {
+    uint64_t uid;
+    uint64_t target_offset; // Index into the section's packed target array
+    uint64_t target_count;
+};
+
+struct FilePathRecord {
+    uint64_t file_uid;
+    uint64_t path_offset; // Into FilePathPool
+    uint32_t path_len;
+    uint32_t reserved;
+};
+
+struct SymbolFileRecord {
+    uint64_t symbol_uid;
+    uint64_t file_uid;
+};
+
+struct FileMetaRecord {
+    uint64_t file_uid;
+    int64_t mtime;
+    uint64_t hash;
+};
+
+// Read-only view over a memory-mapped binary index. Record accessors
+// return pointers directly into the mapping; the view must outlive them.
+class BinaryIndex {
+public:
+
+    BinaryIndex() = default;
+
+    // Throws std::runtime_error on missing file, bad magic, or
+    // incompatible version.
+    void open(const std::string &filepath);
+    bool is_open() const { return mmap_.is_open(); }
+
+    const BinaryIndexHeader &header() const;
+    const SectionEntry *find_section(SectionId id) const;
+
+    // Typed section accessors; return nullptr/0 when the section is absent.
+    const SymbolRecord *symbols(uint64_t &count) const;
+    const AdjacencyRecord *adjacency(SectionId id, uint64_t &count,
+                                     const uint64_t *&targets) const;
+    const FilePathRecord *file_paths(uint64_t &count) const;
+    const SymbolFileRecord *symbol_files(uint64_t &count) const;
+    const FileMetaRecord *file_meta(uint64_t &count) const;
+    std::string_view symbol_name(const SymbolRecord &rec) const;
+    std::string_view file_path(const FilePathRecord &rec) const;
+
+    // Materialize a Graph from the mapping, honoring the same section
+    // skipping rules as the JSON SAX loader. The mask variant reads only
+    // the requested sections' bytes (they are contiguous in the file).
+    Graph to_graph(LoadMode mode) const;
+    Graph to_graph(uint32_t sections) const;
+
+private:
+
+    MemoryMappedFile mmap_;
+
+    const char *section_data(const SectionEntry &entry) const;
+};
+
+// Serialize the finalized graph into the binary format.
+void save_binary_index(const Graph &graph, const std::string &filepath);
+
+// Load a graph from a binary index file. Throws on open/validation failure.
+Graph load_binary_index(const std::string &filepath, LoadMode mode);
+Graph load_binary_index(const std::string &filepath, uint32_t sections);
+
+} // namespace pioneer
@@ -20,22 +20,59 @@
 
 namespace pioneer {
 
-int cmd_index(unsigned int num_threads);
+// On-disk index names in the indexed directory. The binary index is the
+// preferred load source; the JSON index is the interchange/fallback format.
+constexpr const char *INDEX_FILE = ".pioneer.json";
+constexpr const char *BINARY_INDEX_FILE = ".pioneer.idx";
+
+int cmd_index(unsigned int num_threads, bool incremental);
 int cmd_search(const std::vector<std::string> &patterns, bool nosort, bool show_path,
                const Graph &graph);
+int cmd_search(const std::vector<std::string> &patterns, bool nosort, bool show_path,
+               const std::string &scope, const Graph &graph);
 int cmd_search_streaming(const std::vector<std::string> &patterns, bool nosort);
+// Index statistics from the metadata header alone - O(header) bytes read
+int cmd_stats();
+
+// Each query command comes in two flavors: the plain overload loads the index
+// itself (one-shot CLI use), the Graph-taking overload runs against an
+// already-resident graph (daemon mode).
 int cmd_query(const std::vector<std::string> &start_chain,
               const std::vector<std::string> &end_chain, bool backtrace, bool pattern_match,
-              bool nosort, bool show_path);
+              bool nosort, bool show_path, size_t shortest_k = 0, uint32_t exclude_hubs = 0,
+              const std::string &scope = "");
+int cmd_query(const std::vector<std::string> &start_chain,
+              const std::vector<std::string> &end_chain, bool backtrace, bool pattern_match,
+              bool nosort, bool show_path, size_t shortest_k, uint32_t exclude_hubs,
+              const std::string &scope, const Graph &graph);
 int cmd_list_symbols(bool nosort);
+int cmd_list_symbols(bool nosort, const Graph &graph);
 int cmd_list_symbols_streaming(bool nosort);
 int cmd_type(const std::string &symbol, bool nosort);
+int cmd_type(const std::string &symbol, bool nosort, const Graph &graph);
 int cmd_data_sources(const std::vector<std::string> &patterns, bool nosort);
+int cmd_data_sources(const std::vector<std::string> &patterns, bool nosort, const Graph &graph);
 int cmd_data_sinks(const std::vector<std::string> &patterns, bool nosort);
+int cmd_data_sinks(const std::vector<std::string> &patterns, bool nosort, const Graph &graph);
 int cmd_list_variables(const std::vector<std::string> &patterns, bool nosort);
+int cmd_list_variables(const std::vector<std::string> &patterns, bool nosort, const Graph &graph);
 int cmd_callers(const std::vector<std::string> &patterns, bool nosort, bool show_path);
+int cmd_callers(const std::vector<std::string> &patterns, bool nosort, bool show_path,
+                const Graph &graph);
 int cmd_callees(const std::vector<std::string> &patterns, bool nosort, bool show_path);
+int cmd_callees(const std::vector<std::string> &patterns, bool nosort, bool show_path,
+                const Graph &graph);
 int cmd_find_member(const std::vector<std::string> &patterns, bool nosort);
+int cmd_find_member(const std::vector<std::string> &patterns, bool nosort, const Graph &graph);
+// Reachability sweep: first symbol is the source, the rest are targets
+int cmd_reachable(const std::vector<std::string> &symbols);
+int cmd_reachable(const std::vector<std::string> &symbols, const Graph &graph);
+
+// Batch mode: load the index once and run every JSONL query in the file
+// against one QueryEngine, emitting one JSON result object per line.
+// Supported ops: paths, reachable, search, callers, callees, data-sources,
+// data-sinks, type.
+int cmd_batch(const std::string &queries_file);
 int cmd_grep(const std::string &pattern, unsigned int num_threads, bool use_regex,
              bool ignore_case);
 int cmd_grep_streaming(const std::string &pattern, unsigned int num_threads, bool use_regex,
@@ -43,6 +80,11 @@ int cmd_grep_streaming(const std::string &pattern, unsigned int num_threads, boo
 
 bool load_graph(Graph &graph);
 bool load_graph(Graph &graph, LoadMode mode);
+bool load_graph(Graph &graph, uint32_t sections);
+// Federation (--with-index): shard indexes merged by symbol name into every
+// graph load_graph performs, so queries span all shards of a monorepo
+// without a monolithic index build. Set once from main before dispatch.
+void set_federated_indexes(const std::vector<std::string> &paths);
 bool validate_symbol(const class QueryEngine &engine, const std::string &symbol,
                      const std::string &label, bool nosort);
 bool validate_symbol(const class QueryEngine &engine, const std::vector<std::string> &symbols,
@@ -0,0 +1,54 @@
+// Copyright 2025 Siddhant Biradar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace pioneer {
+
+// Daemon mode: load the graph once and serve queries over a unix domain
+// socket in the index directory, so repeated CLI invocations (editor
+// integrations fire dozens per minute) skip the per-process index load.
+//
+// Wire protocol, deliberately trivial: the client sends its argv (minus the
+// program name), one argument per line, terminated by an empty line. The
+// daemon replies with the exit code on the first line followed by the
+// captured command output. "--daemon-stop" as the sole argument shuts the
+// daemon down.
+
+constexpr const char *DAEMON_SOCKET_FILE = ".pioneer.sock";
+
+// Run the daemon loop in the foreground until --daemon-stop or SIGINT/SIGTERM.
+// With watch enabled, the daemon also holds recursive inotify watches on the
+// tree and incrementally re-indexes the resident graph when source files
+// change, republishing the on-disk indexes atomically - so both daemon
+// queries and one-shot invocations see a fresh index within about a second
+// of a save instead of waiting for the next scheduled full run.
+int cmd_daemon(bool watch = false);
+
+// Ask a running daemon to shut down.
+int cmd_daemon_stop();
+
+// True if a daemon is accepting connections on the socket in the current
+// directory (a stale socket file left by a crashed daemon counts as false).
+bool daemon_running();
+
+// Forward this invocation to the running daemon and stream its response.
+// Returns the remote exit code, or -1 if forwarding failed and the caller
+// should fall back to local execution.
+int forward_to_daemon(const std::vector<std::string> &args);
+
+} // namespace pioneer
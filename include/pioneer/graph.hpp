@@ -25,6 +25,34 @@ using json = nlohmann::json;
 
 enum class LoadMode { Full, SymbolsOnly, WithPaths };
 
+// Bitmask of index sections to materialize. Symbols and metadata always
+// load; commands that know their access pattern request just the adjacency
+// they traverse (a backtrace never touches the forward call map, and
+// data-flow maps only matter to data-flow queries). LoadMode remains as
+// the coarse presets most callers use.
+enum GraphSection : uint32_t {
+    SectionCalls = 1u << 0,
+    SectionReverseCalls = 1u << 1,
+    SectionDataFlow = 1u << 2,
+    SectionReverseDataFlow = 1u << 3,
+    SectionFilePaths = 1u << 4, // Path tables plus file<->symbol mappings
+    SectionFileMeta = 1u << 5,
+};
+
+constexpr uint32_t SECTIONS_NONE = 0;
+constexpr uint32_t SECTIONS_ADJACENCY =
+    SectionCalls | SectionReverseCalls | SectionDataFlow | SectionReverseDataFlow;
+constexpr uint32_t SECTIONS_ALL = SECTIONS_ADJACENCY | SectionFilePaths | SectionFileMeta;
+
+constexpr uint32_t sections_for(LoadMode mode) {
+    return mode == LoadMode::SymbolsOnly ? SECTIONS_NONE
+           : mode == LoadMode::WithPaths ? static_cast<uint32_t>(SectionFilePaths)
+                                         : SECTIONS_ALL;
+}
+
+// Contiguous [begin, end) slice into a CsrAdjacency neighbor array.
+using NeighborRange = std::pair<const SymbolUID *, const SymbolUID *>;
+
 class Graph {
 public:
 
@@ -46,6 +74,15 @@ public:
     static Graph from_json(const json &j);
     static Graph load(const std::string &filepath);
     static Graph load(const std::string &filepath, LoadMode mode);
+    static Graph load(const std::string &filepath, uint32_t sections);
+
+    // Merge another graph into this one, remapping its UIDs by symbol name
+    // (the same scheme the indexer uses for parse shards). Identical names
+    // collapse to one UID, which is what resolves cross-shard call edges:
+    // a caller indexed in one shard and its callee's definition in another
+    // meet at the shared name. The packed adjacency is NOT rebuilt here;
+    // callers run build_csr() once after the last merge.
+    void merge(const Graph &other);
 
     SymbolUID get_uid(const std::string &name) const;
     const std::string &get_symbol(SymbolUID uid) const;
@@ -53,6 +90,14 @@ public:
     const std::unordered_set<SymbolUID> &get_callers(SymbolUID callee) const;
     const std::unordered_set<SymbolUID> &get_data_sources(SymbolUID variable) const;
     const std::unordered_set<SymbolUID> &get_data_sinks(SymbolUID source) const;
+    // CSR variants used by the query engine on finalized/loaded graphs; the
+    // hash-map accessors above remain for the mutable build phase.
+    NeighborRange csr_callees(SymbolUID caller) const;
+    NeighborRange csr_callers(SymbolUID callee) const;
+    NeighborRange csr_data_sinks(SymbolUID source) const;
+    NeighborRange csr_data_sources(SymbolUID variable) const;
+    // Caller + callee count, O(1) on finalized/loaded graphs
+    uint32_t symbol_degree(SymbolUID uid) const;
     bool is_variable(SymbolUID uid) const;
     bool has_symbol(const std::string &name) const;
     SymbolUID end_uid() const;
@@ -17,11 +17,15 @@
 #include "graph.hpp"
 #include "parser.hpp"
 #include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace pioneer {
@@ -31,14 +35,30 @@ namespace fs = std::filesystem;
 using IndexProgressCallback =
     std::function<void(const std::string &file, size_t current, size_t total)>;
 
+// Per-file parsers kept alive across incremental runs so an edited file is
+// re-parsed via LanguageParser::reparse (ts_tree_edit re-lexes only the
+// damaged ranges) instead of from scratch. Owned by the watch daemon for its
+// lifetime; one-shot runs pass none and full-parse as before. The mutex
+// guards only map lookup/insert - each file is parsed by exactly one worker,
+// so the parser itself is used without a lock.
+struct ParserCache {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::unique_ptr<LanguageParser>> parsers;
+};
+
 struct IndexerConfig {
     std::string root_path = ".";
     bool verbose = false;
     IndexProgressCallback progress_callback = nullptr;
     unsigned int num_threads = 0; // 0 = auto-detect
+    // Reuse parse results from .pioneer-cache/ for files whose content hash
+    // is unchanged (shared across branches and checkouts of the same tree)
+    bool parse_cache = true;
     std::vector<std::string> ignore_patterns = {"build",  "node_modules", "__pycache__", ".git",
                                                 ".venv",  "venv",         "dist",        "target",
                                                 ".cache", "CMakeFiles"};
+    // Set by watch mode to re-parse edited files incrementally; see ParserCache
+    ParserCache *parser_cache = nullptr;
 };
 
 struct FunctionInfo {
@@ -77,12 +97,75 @@ struct VariableInfo {
     VariableInfo &operator=(const VariableInfo &) = default;
 };
 
+// Per-worker parse output. Each worker owns one shard exclusively, so the
+// parse phase needs no shared-vector locking at all.
+struct ParseShard {
+    std::vector<FunctionInfo> functions;
+    std::vector<CallInfo> calls;
+    std::vector<VariableInfo> variables;
+};
+
+// A source file mapped and faulted in by the reader stage, ready to parse
+// without touching disk.
+struct FileBuffer {
+    fs::path path;
+    MemoryMappedFile mmap;
+};
+
+// Bounded handoff between the reader stage and the parse workers. The
+// capacity caps how many files sit mapped-and-resident at once; readers
+// block when parse falls behind, parse workers block when I/O falls behind.
+struct FileBufferQueue {
+    explicit FileBufferQueue(size_t capacity) : capacity_(capacity) {}
+
+    void push(FileBuffer &&buffer) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [&] { return items_.size() < capacity_; });
+        items_.push_back(std::move(buffer));
+        not_empty_.notify_one();
+    }
+
+    // Returns false once the queue is drained and every reader has finished
+    bool pop(FileBuffer &out) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [&] { return !items_.empty() || closed_; });
+        if (items_.empty()) {
+            return false;
+        }
+        out = std::move(items_.front());
+        items_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        not_empty_.notify_all();
+    }
+
+private:
+
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<FileBuffer> items_;
+    size_t capacity_;
+    bool closed_ = false;
+};
+
 class Indexer {
 public:
 
     explicit Indexer(const IndexerConfig &config = IndexerConfig{});
 
     Graph index();
+
+    // Incremental variant: merges into a previously loaded graph, re-parsing
+    // only files whose mtime/content hash changed since it was built and
+    // evicting symbols and edges of changed/deleted files first.
+    Graph index(Graph previous);
+
     const std::vector<std::string> &indexed_files() const { return indexed_files_; }
 
     struct Stats {
@@ -94,6 +177,11 @@ public:
     };
     const Stats &stats() const { return stats_; }
 
+    // True if discovery would skip this path under the configured ignore
+    // patterns. Public so watch mode filters filesystem events by the same
+    // rules the indexer applies during discovery.
+    bool should_ignore(const fs::path &path) const;
+
 private:
 
     IndexerConfig config_;
@@ -103,14 +191,32 @@ private:
     std::mutex graph_mutex_;
 
     std::vector<fs::path> discover_files();
-    bool should_ignore(const fs::path &path) const;
     bool parse_file(const fs::path &filepath, std::vector<FunctionInfo> &functions_out,
                     std::vector<CallInfo> &calls_out, std::vector<VariableInfo> &variables_out);
-    void worker_parse_files(const std::vector<fs::path> &files, size_t start_idx, size_t end_idx,
-                            std::vector<FunctionInfo> &all_functions,
-                            std::vector<CallInfo> &all_calls,
-                            std::vector<VariableInfo> &all_variables, std::mutex &functions_mutex,
-                            std::mutex &calls_mutex, std::mutex &variables_mutex);
+    bool parse_buffer(const fs::path &filepath, const MemoryMappedFile &mmap,
+                      std::vector<FunctionInfo> &functions_out, std::vector<CallInfo> &calls_out,
+                      std::vector<VariableInfo> &variables_out);
+    // Reader stage: pulls chunks of files from the shared atomic cursor,
+    // maps them and faults the pages in, then hands resident buffers to the
+    // parse workers through the bounded queue. active_readers tracks when
+    // the queue can be closed.
+    void worker_read_files(const std::vector<fs::path> &files, std::atomic<size_t> &next_index,
+                           size_t end_idx, FileBufferQueue &queue,
+                           std::atomic<unsigned int> &active_readers);
+    // Parse stage: consumes fully-resident buffers, so parse cores never
+    // stall on page-fault I/O. Results accumulate in the worker's own shard.
+    void worker_parse_files(FileBufferQueue &queue, ParseShard &shard);
+
+    // Build a thread-local graph (own StringPool and UID space) from one
+    // shard's parse results. short_to_qualified is read-only here.
+    static void
+    build_graph_shard(const ParseShard &shard,
+                      const std::unordered_map<std::string, std::string> &short_to_qualified,
+                      Graph &shard_graph);
+
+    // Merge a shard graph into the final graph, remapping shard-local UIDs
+    // to global ones by symbol name.
+    static void merge_shard(Graph &graph, const Graph &shard_graph);
 };
 
 } // namespace pioneer
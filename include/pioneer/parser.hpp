@@ -15,7 +15,6 @@
 #pragma once
 
 #include "types.hpp"
-#include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -30,34 +29,59 @@ const TSLanguage *tree_sitter_cpp();
 
 namespace pioneer {
 
+// Parse results reference either the parsed source buffer (stable for the
+// lifetime of the parse - the indexer keeps the file memory-mapped) or the
+// parser's per-file arena. Composed names (class prefix + method, function
+// + variable) live in the arena; everything else is a zero-copy view into
+// the source. All views are invalidated by the next parse() call.
 struct FunctionDef {
-    std::string name;
-    std::string qualified_name;
-    std::string containing_class;
-    std::string namespace_path;
-    std::vector<std::string> param_types;
+    std::string_view name;
+    std::string_view qualified_name;
+    std::string_view containing_class;
+    std::string_view namespace_path;
+    std::vector<std::string_view> param_types;
     uint32_t start_line;
     uint32_t end_line;
     TSNode node;
 };
 
 struct FunctionCall {
-    std::string name;
-    std::string qualified_name;
+    std::string_view name;
+    std::string_view qualified_name;
     uint32_t line;
     TSNode node;
 };
 
 struct VariableDef {
-    std::string name;
-    std::string qualified_name;
-    std::string containing_func;
-    std::string value_source;
+    std::string_view name;
+    std::string_view qualified_name;
+    std::string_view containing_func;
+    std::string_view value_source;
     bool from_function_call;
     uint32_t line;
     TSNode node;
 };
 
+// Precompiled tree-sitter query set for one language. Compiled once on first
+// parser construction for that language and shared read-only by every parser
+// (and worker thread) afterwards; each parser keeps its own query cursor.
+// Capture ids are resolved at compile time so extraction dispatches on an
+// integer compare instead of walking the whole tree through a callback.
+struct CompiledQueries {
+    TSQuery *functions = nullptr;
+    TSQuery *calls = nullptr;
+    TSQuery *variables = nullptr;
+
+    uint32_t func_capture = 0;
+    uint32_t class_capture = 0;
+    uint32_t namespace_capture = 0;
+    uint32_t call_capture = 0;
+    uint32_t new_capture = 0;
+    uint32_t decl_capture = 0;
+    uint32_t assign_capture = 0;
+    uint32_t aug_assign_capture = 0;
+};
+
 class LanguageParser {
 public:
 
@@ -72,6 +96,13 @@ public:
     bool parse(const std::string &source);
     bool parse(const char *data, size_t length);
 
+    // Incremental re-parse for edited files: diffs the new source against
+    // the previously parsed one as a single contiguous edit, applies it via
+    // ts_tree_edit, and lets tree-sitter re-lex only the damaged ranges.
+    // Falls back to a full parse when there is no owned previous source to
+    // diff against (first parse, or after a zero-copy parse()).
+    bool reparse(const std::string &source);
+
     std::vector<FunctionDef> extract_functions() const;
     std::vector<FunctionCall> extract_calls(const FunctionDef &func) const;
     std::vector<VariableDef> extract_variables(const FunctionDef &func) const;
@@ -90,7 +121,18 @@ private:
     const char *source_ptr_ = nullptr;
     size_t source_len_ = 0;
 
-    std::string node_text(TSNode node) const;
+    // Shared compiled queries for language_ plus this parser's own cursor,
+    // reused across files (extraction methods are logically const).
+    const CompiledQueries *queries_ = nullptr;
+    mutable TSQueryCursor *cursor_ = nullptr;
+
+    static const CompiledQueries &compiled_queries(Language lang, const TSLanguage *ts_lang);
+
+    std::string_view node_text(TSNode node) const;
+
+    // Per-file scratch space for composed qualified names; reset by parse().
+    // Mutable for the same reason as cursor_: extraction is logically const.
+    mutable Arena arena_;
 
     std::vector<FunctionDef> extract_functions_python() const;
     std::vector<FunctionDef> extract_functions_c() const;
@@ -104,9 +146,8 @@ private:
     std::vector<VariableDef> extract_variables_c(const FunctionDef &func) const;
     std::vector<VariableDef> extract_variables_cpp(const FunctionDef &func) const;
 
-    void visit_nodes(TSNode node, const std::function<void(TSNode)> &visitor) const;
-    std::string build_qualified_name(const std::string &base_name,
-                                     const std::vector<std::string> &param_types) const;
+    std::string_view build_qualified_name(std::string_view base_name,
+                                          const std::vector<std::string_view> &param_types) const;
     std::string build_signature(const std::vector<std::string> &param_types) const;
 };
 
@@ -0,0 +1,95 @@
+// Copyright 2025 Siddhant Biradar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace pioneer {
+
+// Lightweight phase timing and counters behind --profile. Disabled (the
+// default) every instrumentation site is a single relaxed atomic load, so
+// the hooks can stay in release builds. Sections are accumulated by name;
+// hot loops should count locally and report once per call, not per node.
+namespace prof {
+
+bool enabled();
+void set_enabled(bool on);
+
+// Accumulate elapsed time (and one call) against a named section
+void add_time(const char *section, uint64_t nanos);
+
+// Accumulate a named counter (node expansions, cache hits, ...)
+void add_count(const char *counter, uint64_t n);
+
+// Times a scope when profiling is enabled; no-op otherwise
+class ScopedTimer {
+public:
+
+    explicit ScopedTimer(const char *section) : section_(section), armed_(enabled()) {
+        if (armed_) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~ScopedTimer() {
+        if (armed_) {
+            auto elapsed = std::chrono::steady_clock::now() - start_;
+            add_time(section_,
+                     std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+    }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+
+    const char *section_;
+    std::chrono::steady_clock::time_point start_;
+    bool armed_;
+};
+
+// Accumulates locally (a plain integer add in hot loops) and reports the
+// total once on scope exit
+class ScopedCounter {
+public:
+
+    explicit ScopedCounter(const char *counter) : counter_(counter) {}
+
+    ~ScopedCounter() {
+        if (value_ != 0) {
+            add_count(counter_, value_);
+        }
+    }
+
+    void operator+=(uint64_t n) { value_ += n; }
+
+    ScopedCounter(const ScopedCounter &) = delete;
+    ScopedCounter &operator=(const ScopedCounter &) = delete;
+
+private:
+
+    const char *counter_;
+    uint64_t value_ = 0;
+};
+
+// Print everything accumulated so far, sorted by section name
+void report(std::ostream &out, bool as_json);
+
+} // namespace prof
+
+} // namespace pioneer
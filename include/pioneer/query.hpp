@@ -16,6 +16,7 @@
 
 #include "graph.hpp"
 #include <functional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -23,20 +24,55 @@ namespace pioneer {
 
 using PathCallback = std::function<bool(const std::vector<std::string> &path)>;
 
+// UID-level variant: the span views the enumerator's working storage and is
+// only valid for the duration of the call. Stringify via Graph::get_symbol
+// when (and if) the path is actually printed; enumeration itself then does
+// no per-path string work.
+using UidPathCallback = std::function<bool(std::span<const SymbolUID> path)>;
+
 class QueryEngine {
 public:
 
     explicit QueryEngine(const Graph &graph);
 
     void find_paths(const std::string &start, const std::string &end, PathCallback callback);
+    void find_paths(const std::string &start, const std::string &end, UidPathCallback callback);
+    // Shortest-first alternative to find_paths: emits up to k loopless paths
+    // in non-decreasing length order and stops, instead of exhaustively
+    // enumerating every path. Requires specific start and end symbols.
+    void find_shortest_paths(const std::string &start, const std::string &end, size_t k,
+                             PathCallback callback);
+    void find_shortest_paths(const std::string &start, const std::string &end, size_t k,
+                             UidPathCallback callback);
+    // O(1) reachability after the first query per start symbol: the forward
+    // closure of the start's SCC is computed once and cached, so sweeps that
+    // test many ends against one start pay for a single DAG traversal.
+    bool is_reachable(const std::string &start, const std::string &end) const;
     void backtrace(const std::string &symbol, PathCallback callback);
+    void backtrace(const std::string &symbol, UidPathCallback callback);
     void forward_trace(const std::string &symbol, PathCallback callback);
+    void forward_trace(const std::string &symbol, UidPathCallback callback);
+    // Hub pruning for path searches: when set, symbols whose caller+callee
+    // count exceeds the limit are never expanded (the start and end symbols
+    // themselves are exempt), so traversals stay out of mega-hubs like
+    // loggers. 0 disables pruning.
+    void set_hub_limit(uint32_t max_degree) { hub_limit_ = max_degree; }
+
+    // Directory scoping (--scope): restricts path searches and symbol
+    // matching to symbols whose defining file lives under dir, resolved
+    // through the path trie and the file-to-symbol tables, so traversals
+    // prune at expansion time instead of filtering graph-wide output.
+    // Returns false when no indexed file lives under dir; an empty dir
+    // clears the scope.
+    bool set_scope(const std::string &dir);
+
     bool has_symbol(const std::string &name) const;
     std::vector<std::string> find_symbols(const std::vector<std::string> &patterns) const;
     std::vector<std::string> find_symbols(const std::string &pattern) const;
     static void print_path(const std::vector<std::string> &path);
     static void print_path(const std::vector<std::string> &path, const Graph &graph,
                            bool show_paths);
+    static void print_path(std::span<const SymbolUID> path, const Graph &graph, bool show_paths);
 
     // Immediate caller/callee queries
     std::vector<std::string> immediate_callers(const std::string &symbol) const;
@@ -53,9 +89,27 @@ private:
 
     const Graph &graph_;
 
-    void dfs_forward(SymbolUID start, SymbolUID end, PathCallback &callback);
-    void dfs_backward(SymbolUID start, SymbolUID end, PathCallback &callback);
-    void dfs_bidirectional(SymbolUID start, SymbolUID end, PathCallback &callback);
+    uint32_t hub_limit_ = 0;
+
+    // Per-UID allow bitmap for the active --scope; empty when unscoped
+    std::vector<uint8_t> scope_allowed_;
+    bool scope_enabled_ = false;
+
+    bool skip_hub(SymbolUID uid) const;
+    bool out_of_scope(SymbolUID uid) const;
+
+    // Cached forward closures over the condensation, keyed by source SCC
+    mutable std::unordered_map<uint32_t, std::vector<uint8_t>> reach_cache_;
+
+    const std::vector<uint8_t> &reachable_from(uint32_t source_scc) const;
+
+    // Adapt a string-level callback for the UID-level enumerators
+    UidPathCallback stringify(PathCallback callback) const;
+
+    void dfs_forward(SymbolUID start, SymbolUID end, UidPathCallback &callback);
+    void dfs_backward(SymbolUID start, SymbolUID end, UidPathCallback &callback);
+    void dfs_bidirectional(SymbolUID start, SymbolUID end, UidPathCallback &callback);
+    void bfs_k_shortest(SymbolUID start, SymbolUID end, size_t k, UidPathCallback &callback);
     void dfs_data_flow(SymbolUID source, SymbolUID target, PathCallback &callback);
 };
 
@@ -0,0 +1,45 @@
+// Copyright 2025 Siddhant Biradar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pioneer {
+namespace simd {
+
+// Vectorized substring containment, the hot primitive behind --search and
+// friends: symbol matching runs this once per candidate symbol per pattern.
+// On x86-64 the kernel broadcasts the first and last needle bytes, scans the
+// haystack a register at a time, and verifies the needle middle only where
+// both line up; the widest variant the CPU supports (AVX2, else SSE2) is
+// picked once at startup. Other architectures fall back to std::string_view
+// matching.
+bool contains(std::string_view haystack, std::string_view needle);
+
+// True when every pattern occurs in the haystack; short-circuits on the
+// first miss, so callers should put the most selective pattern first.
+inline bool contains_all(std::string_view haystack, const std::vector<std::string> &needles) {
+    for (const auto &needle : needles) {
+        if (!contains(haystack, needle)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace simd
+} // namespace pioneer
@@ -72,9 +72,43 @@ public:
     bool parse_error(std::size_t, const std::string &, const nlohmann::json::exception &) override;
 };
 
+// Builds the metadata header (counts, stats section) as a json object and
+// stops parsing at the UIDs table, so only the first few kilobytes of the
+// index are ever decompressed.
+class StreamingMetadataHandler : public nlohmann::json::json_sax_t {
+public:
+
+    nlohmann::json metadata = nlohmann::json::object();
+    bool done = false;
+    bool in_metadata = false;
+    int depth = 0;
+    std::string current_key;
+    std::vector<nlohmann::json *> stack;
+
+    bool null() override;
+    bool boolean(bool) override;
+    bool number_integer(number_integer_t) override;
+    bool number_unsigned(number_unsigned_t) override;
+    bool number_float(number_float_t, const string_t &) override;
+    bool string(string_t &val) override;
+    bool binary(binary_t &) override;
+    bool start_object(std::size_t) override;
+    bool end_object() override;
+    bool start_array(std::size_t) override;
+    bool end_array() override;
+    bool key(string_t &key) override;
+    bool parse_error(std::size_t, const std::string &, const nlohmann::json::exception &) override;
+
+private:
+
+    bool append(nlohmann::json &&val);
+    nlohmann::json *push_container(nlohmann::json &&container);
+};
+
 std::vector<std::string> stream_search_symbols(const std::string &index_file,
                                                const std::vector<std::string> &patterns);
 std::vector<std::string> stream_all_symbols(const std::string &index_file);
 std::vector<std::string> stream_file_paths(const std::string &index_file);
+nlohmann::json stream_index_metadata(const std::string &index_file);
 
 } // namespace pioneer
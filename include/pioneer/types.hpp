@@ -16,7 +16,9 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <deque>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <string>
@@ -91,6 +93,17 @@ public:
         return true;
     }
 
+    // Touch every page so the mapping is fully resident. Meant to run on an
+    // I/O thread before the buffer is handed to a compute thread, which then
+    // never blocks on a page fault.
+    void prefault() const {
+        volatile uint64_t sum = 0;
+        for (size_t off = 0; off < size_; off += 4096) {
+            sum = sum + static_cast<unsigned char>(data_[off]);
+        }
+        (void)sum;
+    }
+
     void close() {
         if (data_) {
             madvise(const_cast<char *>(data_), size_, MADV_DONTNEED);
@@ -164,6 +177,87 @@ private:
     std::unordered_map<std::string_view, size_t> index_;
 };
 
+// Bump allocator for short-lived strings composed during parsing (qualified
+// names and the like). Allocations are appended to fixed-size blocks and
+// freed all at once via reset(), which keeps the blocks for reuse by the
+// next file - no per-string malloc/free at all in the steady state.
+class Arena {
+public:
+
+    explicit Arena(size_t block_size = 64 * 1024) : block_size_(block_size) {}
+
+    // Copy text into the arena and return a view that stays valid until the
+    // next reset().
+    std::string_view store(std::string_view text) {
+        if (text.empty())
+            return {};
+        char *dst = allocate(text.size());
+        std::memcpy(dst, text.data(), text.size());
+        return {dst, text.size()};
+    }
+
+    // Concatenate up to three pieces into one arena-backed string.
+    std::string_view concat(std::string_view a, std::string_view b, std::string_view c = {}) {
+        size_t total = a.size() + b.size() + c.size();
+        if (total == 0)
+            return {};
+        char *dst = allocate(total);
+        std::memcpy(dst, a.data(), a.size());
+        std::memcpy(dst + a.size(), b.data(), b.size());
+        if (!c.empty()) {
+            std::memcpy(dst + a.size() + b.size(), c.data(), c.size());
+        }
+        return {dst, total};
+    }
+
+    // Invalidates every view handed out so far; existing blocks are reused.
+    void reset() {
+        current_ = 0;
+        used_ = 0;
+    }
+
+private:
+
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    char *allocate(size_t size) {
+        while (current_ < blocks_.size()) {
+            if (used_ + size <= blocks_[current_].size) {
+                char *ptr = blocks_[current_].data.get() + used_;
+                used_ += size;
+                return ptr;
+            }
+            ++current_;
+            used_ = 0;
+        }
+        // Oversized requests get a dedicated block so block_size_ stays a
+        // soft limit, not a hard one.
+        size_t capacity = std::max(size, block_size_);
+        blocks_.push_back({std::unique_ptr<char[]>(new char[capacity]), capacity});
+        current_ = blocks_.size() - 1;
+        used_ = size;
+        return blocks_.back().data.get();
+    }
+
+    std::vector<Block> blocks_;
+    size_t block_size_;
+    size_t current_ = 0;
+    size_t used_ = 0;
+};
+
+// 64-bit FNV-1a, used for index content hashes.
+inline uint64_t fnv1a_hash(const char *data, size_t size) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
 using SymbolUID = uint64_t;
 
 constexpr SymbolUID INVALID_UID = 0;
@@ -231,6 +325,278 @@ struct PathNode {
     std::vector<SymbolUID> file_uids;
 };
 
+// Per-file freshness info recorded at index time so later runs can skip
+// unchanged files. hash == 0 means "not yet computed".
+struct FileMeta {
+    int64_t mtime = 0;
+    uint64_t hash = 0;
+};
+
+// Immutable compressed-sparse-row adjacency built from one of the mutable
+// hash-map adjacencies once the graph is complete. UIDs are dense (allocated
+// sequentially from 1), so offsets are indexed by UID directly and each
+// neighbor list is a contiguous, sorted slice of one packed array.
+struct CsrAdjacency {
+    std::vector<uint64_t> offsets; // Indexed by UID; size max_uid + 2
+    std::vector<SymbolUID> targets;
+    bool built = false;
+
+    void build(const std::unordered_map<SymbolUID, std::unordered_set<SymbolUID>> &map,
+               SymbolUID max_uid) {
+        offsets.assign(max_uid + 2, 0);
+        size_t total = 0;
+        for (const auto &[uid, neighbors] : map) {
+            offsets[uid + 1] = neighbors.size();
+            total += neighbors.size();
+        }
+        for (size_t i = 1; i < offsets.size(); ++i) {
+            offsets[i] += offsets[i - 1];
+        }
+        targets.resize(total);
+        for (const auto &[uid, neighbors] : map) {
+            size_t pos = offsets[uid];
+            for (SymbolUID target : neighbors) {
+                targets[pos++] = target;
+            }
+            std::sort(targets.begin() + offsets[uid], targets.begin() + pos);
+        }
+        built = true;
+    }
+
+    std::pair<const SymbolUID *, const SymbolUID *> neighbors(SymbolUID uid) const {
+        if (!built || uid + 1 >= offsets.size()) {
+            return {nullptr, nullptr};
+        }
+        return {targets.data() + offsets[uid], targets.data() + offsets[uid + 1]};
+    }
+
+    bool empty_row(SymbolUID uid) const {
+        return !built || uid + 1 >= offsets.size() || offsets[uid] == offsets[uid + 1];
+    }
+
+    size_t row_size(SymbolUID uid) const {
+        if (!built || uid + 1 >= offsets.size()) {
+            return 0;
+        }
+        return offsets[uid + 1] - offsets[uid];
+    }
+
+    // Reorder every neighbor row so low-degree targets come first, ties
+    // broken by UID to keep enumeration deterministic. Traversals that walk
+    // rows front to back then try quiet symbols before mega-hubs (loggers,
+    // allocators), which finds short useful paths before drowning in hub
+    // fan-out.
+    void sort_rows_by_degree(const std::vector<uint32_t> &degree) {
+        if (!built) {
+            return;
+        }
+        auto deg = [&](SymbolUID uid) -> uint32_t {
+            return uid < degree.size() ? degree[uid] : 0;
+        };
+        for (size_t row = 0; row + 1 < offsets.size(); ++row) {
+            std::sort(targets.begin() + static_cast<ptrdiff_t>(offsets[row]),
+                      targets.begin() + static_cast<ptrdiff_t>(offsets[row + 1]),
+                      [&](SymbolUID a, SymbolUID b) {
+                          uint32_t da = deg(a);
+                          uint32_t db = deg(b);
+                          return da != db ? da < db : a < b;
+                      });
+        }
+    }
+
+    void clear() {
+        offsets.clear();
+        targets.clear();
+        built = false;
+    }
+};
+
+// Tarjan condensation of the finalized call graph. scc_of maps every UID to
+// a dense SCC id; dag/dag_reverse hold the edges between distinct SCCs. On
+// acyclic regions every SCC is a single symbol, so a traversal of the DAG is
+// exactly a traversal of the call graph; mutual-recursion clusters collapse
+// to one DAG node each, which is what keeps path queries bounded there.
+struct SccCondensation {
+    static constexpr uint32_t UNASSIGNED = UINT32_MAX;
+
+    std::vector<uint32_t> scc_of; // Indexed by UID
+    std::vector<uint32_t> scc_size;
+    uint32_t count = 0;
+    CsrAdjacency dag;
+    CsrAdjacency dag_reverse;
+    bool built = false;
+
+    // Iterative Tarjan over the packed forward adjacency; requires a built
+    // CSR (any later mutation of the graph invalidates the condensation).
+    void build(const CsrAdjacency &graph, SymbolUID max_uid) {
+        scc_of.assign(max_uid + 1, UNASSIGNED);
+        scc_size.clear();
+        count = 0;
+
+        std::vector<uint32_t> index(max_uid + 1, UNASSIGNED);
+        std::vector<uint32_t> lowlink(max_uid + 1, 0);
+        std::vector<bool> on_stack(max_uid + 1, false);
+        std::vector<SymbolUID> scc_stack;
+
+        struct Frame {
+            SymbolUID node;
+            const SymbolUID *current_it;
+            const SymbolUID *end_it;
+        };
+        std::vector<Frame> frames;
+        uint32_t next_index = 0;
+
+        for (SymbolUID root = 1; root <= max_uid; ++root) {
+            if (index[root] != UNASSIGNED) {
+                continue;
+            }
+
+            index[root] = lowlink[root] = next_index++;
+            scc_stack.push_back(root);
+            on_stack[root] = true;
+            auto [root_begin, root_end] = graph.neighbors(root);
+            frames.push_back({root, root_begin, root_end});
+
+            while (!frames.empty()) {
+                Frame &frame = frames.back();
+                if (frame.current_it != frame.end_it) {
+                    SymbolUID next = *frame.current_it;
+                    ++frame.current_it;
+                    if (index[next] == UNASSIGNED) {
+                        index[next] = lowlink[next] = next_index++;
+                        scc_stack.push_back(next);
+                        on_stack[next] = true;
+                        auto [next_begin, next_end] = graph.neighbors(next);
+                        frames.push_back({next, next_begin, next_end});
+                    } else if (on_stack[next]) {
+                        lowlink[frame.node] = std::min(lowlink[frame.node], index[next]);
+                    }
+                    continue;
+                }
+
+                if (lowlink[frame.node] == index[frame.node]) {
+                    uint32_t members = 0;
+                    SymbolUID popped;
+                    do {
+                        popped = scc_stack.back();
+                        scc_stack.pop_back();
+                        on_stack[popped] = false;
+                        scc_of[popped] = count;
+                        ++members;
+                    } while (popped != frame.node);
+                    scc_size.push_back(members);
+                    ++count;
+                }
+
+                SymbolUID finished = frame.node;
+                frames.pop_back();
+                if (!frames.empty()) {
+                    lowlink[frames.back().node] =
+                        std::min(lowlink[frames.back().node], lowlink[finished]);
+                }
+            }
+        }
+
+        // Edges between distinct SCCs, packed the same way as the call graph
+        std::unordered_map<SymbolUID, std::unordered_set<SymbolUID>> dag_map;
+        std::unordered_map<SymbolUID, std::unordered_set<SymbolUID>> dag_reverse_map;
+        for (SymbolUID uid = 1; uid <= max_uid; ++uid) {
+            auto [it, end_it] = graph.neighbors(uid);
+            for (; it != end_it; ++it) {
+                uint32_t from = scc_of[uid];
+                uint32_t to = scc_of[*it];
+                if (from != to) {
+                    dag_map[from].insert(to);
+                    dag_reverse_map[to].insert(from);
+                }
+            }
+        }
+        dag.build(dag_map, count);
+        dag_reverse.build(dag_reverse_map, count);
+        built = true;
+    }
+
+    void clear() {
+        scc_of.clear();
+        scc_size.clear();
+        count = 0;
+        dag.clear();
+        dag_reverse.clear();
+        built = false;
+    }
+};
+
+// Trigram posting lists over the symbol table so substring search touches
+// only candidate symbols instead of scanning every name. A candidate must
+// contain every trigram of the pattern; callers still verify the actual
+// substring match, so false positives cost one find() and false negatives
+// cannot occur. Patterns shorter than one trigram fall back to a scan.
+struct TrigramIndex {
+    std::unordered_map<uint32_t, std::vector<SymbolUID>> postings;
+    bool built = false;
+
+    static uint32_t pack(const char *s) {
+        return (static_cast<uint32_t>(static_cast<uint8_t>(s[0])) << 16) |
+               (static_cast<uint32_t>(static_cast<uint8_t>(s[1])) << 8) |
+               static_cast<uint32_t>(static_cast<uint8_t>(s[2]));
+    }
+
+    void build(const std::unordered_map<std::string, SymbolUID> &symbol_to_uid) {
+        postings.clear();
+        for (const auto &[name, uid] : symbol_to_uid) {
+            for (size_t i = 0; i + 3 <= name.size(); ++i) {
+                postings[pack(name.data() + i)].push_back(uid);
+            }
+        }
+        // Repeated trigrams within one name produce duplicate entries
+        for (auto &[trigram, uids] : postings) {
+            std::sort(uids.begin(), uids.end());
+            uids.erase(std::unique(uids.begin(), uids.end()), uids.end());
+            uids.shrink_to_fit();
+        }
+        built = true;
+    }
+
+    // Fills out with the UIDs whose names contain every trigram of pattern.
+    // Returns false when the index cannot answer (not built, or the pattern
+    // is shorter than one trigram) and the caller must scan instead.
+    bool candidates(const std::string &pattern, std::vector<SymbolUID> &out) const {
+        out.clear();
+        if (!built || pattern.size() < 3) {
+            return false;
+        }
+
+        std::vector<const std::vector<SymbolUID> *> lists;
+        for (size_t i = 0; i + 3 <= pattern.size(); ++i) {
+            auto it = postings.find(pack(pattern.data() + i));
+            if (it == postings.end()) {
+                return true; // Some trigram occurs nowhere: no candidates
+            }
+            lists.push_back(&it->second);
+        }
+
+        // Intersect starting from the rarest list so out stays small
+        std::sort(lists.begin(), lists.end(),
+                  [](const auto *a, const auto *b) { return a->size() < b->size(); });
+        out = *lists[0];
+        std::vector<SymbolUID> narrowed;
+        for (size_t i = 1; i < lists.size() && !out.empty(); ++i) {
+            narrowed.clear();
+            std::set_intersection(out.begin(), out.end(), lists[i]->begin(), lists[i]->end(),
+                                  std::back_inserter(narrowed));
+            out.swap(narrowed);
+        }
+        return true;
+    }
+
+    void clear() {
+        postings.clear();
+        built = false;
+    }
+};
+
+PathNode build_path_trie(const std::unordered_map<SymbolUID, std::string> &file_uid_to_path);
+
 struct CallGraph {
     StringPool symbol_pool;
     std::unordered_map<std::string, SymbolUID> symbol_to_uid;
@@ -242,6 +608,7 @@ struct CallGraph {
     std::unordered_map<SymbolUID, size_t> file_uid_to_path_idx;
     std::unordered_map<SymbolUID, std::vector<SymbolUID>> file_to_symbols;
     std::unordered_map<SymbolUID, SymbolUID> symbol_to_file;
+    std::unordered_map<SymbolUID, FileMeta> file_meta;
     SymbolUID next_file_uid = 1;
 
     std::unordered_map<SymbolUID, std::unordered_set<SymbolUID>> call_map;
@@ -249,9 +616,61 @@ struct CallGraph {
     std::unordered_map<SymbolUID, std::unordered_set<SymbolUID>> data_flow_map;
     std::unordered_map<SymbolUID, std::unordered_set<SymbolUID>> reverse_data_flow_map;
 
+    // Finalized traversal layout; the hash maps above stay authoritative
+    // for the mutable build phase and serialization.
+    CsrAdjacency csr_call;
+    CsrAdjacency csr_reverse_call;
+    CsrAdjacency csr_data_flow;
+    CsrAdjacency csr_reverse_data_flow;
+
+    // Built on demand by the first substring search (mutable because lookups
+    // are const); invalidated whenever a new symbol is interned.
+    mutable TrigramIndex trigram_index;
+
+    // Built on demand by the first start/end path query; invalidated by
+    // build_csr() since it is derived from the packed call adjacency.
+    mutable SccCondensation scc_condensation;
+
+    // Built on demand by the first directory-scoped query (the serialized
+    // trie in the JSON index is skipped on load; rebuilding from the
+    // file-path table is cheaper than parsing it).
+    mutable PathNode path_trie_root;
+    mutable bool path_trie_built = false;
+
     SymbolUID next_uid = 1;
     SymbolUID end_uid = INVALID_UID;
 
+    // Running per-type tallies so num_functions()/num_variables() are O(1);
+    // every type write goes through set_symbol_type and every erase through
+    // remove_symbol, both of which keep these in step
+    size_t function_count = 0;
+    size_t variable_count = 0;
+
+    void count_type(SymbolType type, long delta) {
+        size_t *counter = nullptr;
+        if (type == SymbolType::Function) {
+            counter = &function_count;
+        } else if (type == SymbolType::Variable) {
+            counter = &variable_count;
+        }
+        if (counter) {
+            *counter = static_cast<size_t>(static_cast<long>(*counter) + delta);
+        }
+    }
+
+    // Record (or change) a symbol's type, keeping the type tallies in step
+    void set_symbol_type(SymbolUID uid, SymbolType type) {
+        auto [it, inserted] = symbol_types.try_emplace(uid, type);
+        if (!inserted) {
+            if (it->second == type) {
+                return;
+            }
+            count_type(it->second, -1);
+            it->second = type;
+        }
+        count_type(type, 1);
+    }
+
     SymbolUID get_or_create_uid(const std::string &symbol_name,
                                 SymbolType type = SymbolType::Function) {
         auto it = symbol_to_uid.find(symbol_name);
@@ -262,7 +681,10 @@ struct CallGraph {
         size_t str_idx = symbol_pool.intern(symbol_name);
         symbol_to_uid[symbol_name] = uid;
         uid_to_string_idx[uid] = str_idx;
-        symbol_types[uid] = type;
+        set_symbol_type(uid, type);
+        if (trigram_index.built) {
+            trigram_index.clear();
+        }
         return uid;
     }
 
@@ -297,12 +719,80 @@ struct CallGraph {
         reverse_data_flow_map[source].insert(variable);
     }
 
+    // Drop edges originating from a symbol, keeping the symbol record (and
+    // its incoming edges) intact. Used when a file changed and is about to
+    // be re-parsed: the re-parse reuses the same UID via get_or_create_uid,
+    // so edges from unchanged callers stay valid.
+    void remove_outgoing_edges(SymbolUID uid) {
+        auto cit = call_map.find(uid);
+        if (cit != call_map.end()) {
+            for (SymbolUID callee : cit->second) {
+                auto rit = reverse_call_map.find(callee);
+                if (rit != reverse_call_map.end()) {
+                    rit->second.erase(uid);
+                }
+            }
+            call_map.erase(cit);
+        }
+
+        auto dit = data_flow_map.find(uid);
+        if (dit != data_flow_map.end()) {
+            for (SymbolUID dest : dit->second) {
+                auto rit = reverse_data_flow_map.find(dest);
+                if (rit != reverse_data_flow_map.end()) {
+                    rit->second.erase(uid);
+                }
+            }
+            data_flow_map.erase(dit);
+        }
+    }
+
+    // Fully remove a symbol: outgoing and incoming edges plus all records.
+    // Used when the file that defined the symbol was deleted.
+    void remove_symbol(SymbolUID uid) {
+        remove_outgoing_edges(uid);
+
+        auto rit = reverse_call_map.find(uid);
+        if (rit != reverse_call_map.end()) {
+            for (SymbolUID caller : rit->second) {
+                auto cit = call_map.find(caller);
+                if (cit != call_map.end()) {
+                    cit->second.erase(uid);
+                }
+            }
+            reverse_call_map.erase(rit);
+        }
+
+        auto rdit = reverse_data_flow_map.find(uid);
+        if (rdit != reverse_data_flow_map.end()) {
+            for (SymbolUID source : rdit->second) {
+                auto dit = data_flow_map.find(source);
+                if (dit != data_flow_map.end()) {
+                    dit->second.erase(uid);
+                }
+            }
+            reverse_data_flow_map.erase(rdit);
+        }
+
+        auto sit = uid_to_string_idx.find(uid);
+        if (sit != uid_to_string_idx.end()) {
+            symbol_to_uid.erase(symbol_pool.get(sit->second));
+            uid_to_string_idx.erase(sit);
+        }
+        auto tit = symbol_types.find(uid);
+        if (tit != symbol_types.end()) {
+            count_type(tit->second, -1);
+            symbol_types.erase(tit);
+        }
+        symbol_to_file.erase(uid);
+    }
+
     void finalize() {
         end_uid = next_uid++;
         size_t end_str_idx = symbol_pool.intern("END");
         symbol_to_uid["END"] = end_uid;
         uid_to_string_idx[end_uid] = end_str_idx;
-        symbol_types[end_uid] = SymbolType::End;
+        set_symbol_type(end_uid, SymbolType::End);
 
         std::unordered_set<SymbolUID> all_symbols;
         for (const auto &[name, uid] : symbol_to_uid) {
@@ -318,6 +808,65 @@ struct CallGraph {
         }
 
         shrink_to_fit();
+        build_csr();
+    }
+
+    // (Re)build the packed adjacency from the hash maps. Called from
+    // finalize() and after index loads; any later mutation of the hash maps
+    // requires another call before traversal.
+    void build_csr() {
+        csr_call.build(call_map, next_uid);
+        csr_reverse_call.build(reverse_call_map, next_uid);
+        csr_data_flow.build(data_flow_map, next_uid);
+        csr_reverse_data_flow.build(reverse_data_flow_map, next_uid);
+
+        // Degree-aware expansion order for the call adjacency: path searches
+        // walk rows front to back, so listing low-degree neighbors first
+        // defers hub symbols until the quiet candidates are exhausted.
+        std::vector<uint32_t> degree(static_cast<size_t>(next_uid) + 1, 0);
+        for (SymbolUID uid = 0; uid < degree.size(); ++uid) {
+            degree[uid] = symbol_degree(uid);
+        }
+        csr_call.sort_rows_by_degree(degree);
+        csr_reverse_call.sort_rows_by_degree(degree);
+
+        scc_condensation.clear();
+    }
+
+    bool csr_built() const { return csr_call.built; }
+
+    // Caller + callee count for one symbol; O(1) from the packed adjacency
+    // row extents, so hub checks in the query engine cost two array reads.
+    uint32_t symbol_degree(SymbolUID uid) const {
+        return static_cast<uint32_t>(csr_call.row_size(uid) + csr_reverse_call.row_size(uid));
+    }
+
+    // Requires a built CSR (always the case after finalize() or a full load)
+    const SccCondensation &condensation() const {
+        if (!scc_condensation.built) {
+            scc_condensation.build(csr_call, next_uid);
+        }
+        return scc_condensation;
+    }
+
+    const TrigramIndex &symbol_trigrams() const {
+        if (!trigram_index.built) {
+            trigram_index.build(symbol_to_uid);
+        }
+        return trigram_index;
+    }
+
+    const PathNode &path_trie() const {
+        if (!path_trie_built) {
+            std::unordered_map<SymbolUID, std::string> file_uid_to_path;
+            file_uid_to_path.reserve(file_uid_to_path_idx.size());
+            for (const auto &[file_uid, path_idx] : file_uid_to_path_idx) {
+                file_uid_to_path[file_uid] = filepath_pool.get(path_idx);
+            }
+            path_trie_root = build_path_trie(file_uid_to_path);
+            path_trie_built = true;
+        }
+        return path_trie_root;
     }
 
     void shrink_to_fit() {
@@ -336,23 +885,9 @@ struct CallGraph {
 
     size_t num_symbols() const { return symbol_to_uid.size() - (end_uid != INVALID_UID ? 1 : 0); }
 
-    size_t num_functions() const {
-        size_t count = 0;
-        for (const auto &[uid, type] : symbol_types) {
-            if (type == SymbolType::Function)
-                count++;
-        }
-        return count;
-    }
+    size_t num_functions() const { return function_count; }
 
-    size_t num_variables() const {
-        size_t count = 0;
-        for (const auto &[uid, type] : symbol_types) {
-            if (type == SymbolType::Variable)
-                count++;
-        }
-        return count;
-    }
+    size_t num_variables() const { return variable_count; }
 };
 
 inline void add_to_path_trie(PathNode &root, const std::string &filepath, SymbolUID file_uid) {
@@ -22,9 +22,9 @@ constexpr int VERSION_PATCH = 0;
 constexpr const char *VERSION_STRING = "2.3.0";
 
 constexpr int INDEX_SCHEMA_MAJOR = 2;
-constexpr int INDEX_SCHEMA_MINOR = 2;
+constexpr int INDEX_SCHEMA_MINOR = 3;
 constexpr int INDEX_SCHEMA_PATCH = 0;
-constexpr const char *INDEX_SCHEMA_VERSION = "2.2.0";
+constexpr const char *INDEX_SCHEMA_VERSION = "2.3.0";
 
 constexpr int MIN_COMPAT_SCHEMA_MAJOR = 1;
 constexpr int MIN_COMPAT_SCHEMA_MINOR = 2;
@@ -0,0 +1,112 @@
+// Copyright 2025 Siddhant Biradar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+// Opaque zstd context types (zstd.h is only pulled into the translation unit)
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+
+namespace pioneer {
+
+// True when the stream begins with a zstd frame magic; the read position is
+// restored, so callers can hand the same stream to either decode path.
+bool stream_is_zstd(std::istream &in);
+
+// Compressing streambuf over an ostream. Input is framed: a frame is closed
+// every ~32 MiB of uncompressed data (roughly one index section per frame at
+// our section sizes), so the output is a plain sequence of independent zstd
+// frames that any streaming decoder can walk section by section.
+class ZstdOutBuf : public std::streambuf {
+public:
+
+    explicit ZstdOutBuf(std::ostream &sink);
+    ~ZstdOutBuf() override;
+
+    ZstdOutBuf(const ZstdOutBuf &) = delete;
+    ZstdOutBuf &operator=(const ZstdOutBuf &) = delete;
+
+    // Close the current frame and flush the sink; further writes are invalid
+    void finish();
+
+protected:
+
+    int overflow(int ch) override;
+    int sync() override;
+
+private:
+
+    void compress_pending(bool end_frame);
+
+    std::ostream &sink_;
+    ZSTD_CCtx_s *cctx_ = nullptr;
+    std::vector<char> in_buf_;
+    std::vector<char> out_buf_;
+    size_t frame_bytes_ = 0;
+    bool finished_ = false;
+};
+
+// Decompressing streambuf over an istream of concatenated zstd frames
+class ZstdInBuf : public std::streambuf {
+public:
+
+    explicit ZstdInBuf(std::istream &source);
+    ~ZstdInBuf() override;
+
+    ZstdInBuf(const ZstdInBuf &) = delete;
+    ZstdInBuf &operator=(const ZstdInBuf &) = delete;
+
+protected:
+
+    int underflow() override;
+
+private:
+
+    std::istream &source_;
+    ZSTD_DCtx_s *dctx_ = nullptr;
+    std::vector<char> in_buf_;
+    std::vector<char> out_buf_;
+    size_t in_pos_ = 0;
+    size_t in_size_ = 0;
+};
+
+// Convenience ostream/istream wrappers owning their buffers
+class ZstdOstream : public std::ostream {
+public:
+
+    explicit ZstdOstream(std::ostream &sink) : std::ostream(&buf_), buf_(sink) {}
+
+    void finish() { buf_.finish(); }
+
+private:
+
+    ZstdOutBuf buf_;
+};
+
+class ZstdIstream : public std::istream {
+public:
+
+    explicit ZstdIstream(std::istream &source) : std::istream(&buf_), buf_(source) {}
+
+private:
+
+    ZstdInBuf buf_;
+};
+
+} // namespace pioneer
@@ -0,0 +1,486 @@
+// Copyright 2025 Siddhant Biradar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pioneer/binary_index.hpp"
+#include "pioneer/profile.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace pioneer {
+
+namespace {
+
+// Incremental writer that tracks section offsets as payloads are appended.
+class SectionWriter {
+public:
+
+    explicit SectionWriter(std::ofstream &out) : out_(out) {}
+
+    void reserve_layout(uint32_t section_count) {
+        offset_ = sizeof(BinaryIndexHeader) + section_count * sizeof(SectionEntry);
+        out_.seekp(static_cast<std::streamoff>(offset_));
+    }
+
+    void begin_section(SectionId id) {
+        current_.id = static_cast<uint32_t>(id);
+        current_.reserved = 0;
+        current_.offset = offset_;
+        current_.size = 0;
+        current_.count = 0;
+    }
+
+    void write(const void *data, size_t size) {
+        out_.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+        current_.size += size;
+        offset_ += size;
+    }
+
+    template <typename T> void write_record(const T &rec) { write(&rec, sizeof(T)); }
+
+    void end_section(uint64_t count) {
+        current_.count = count;
+        entries_.push_back(current_);
+    }
+
+    const std::vector<SectionEntry> &entries() const { return entries_; }
+
+private:
+
+    std::ofstream &out_;
+    uint64_t offset_ = 0;
+    SectionEntry current_{};
+    std::vector<SectionEntry> entries_;
+};
+
+void write_adjacency_section(
+    SectionWriter &writer, SectionId id,
+    const std::unordered_map<SymbolUID, std::unordered_set<SymbolUID>> &map) {
+    writer.begin_section(id);
+
+    std::vector<SymbolUID> keys;
+    keys.reserve(map.size());
+    for (const auto &[uid, targets] : map) {
+        keys.push_back(uid);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    // Key records first, then the packed target array they index into.
+    uint64_t target_offset = 0;
+    for (SymbolUID uid : keys) {
+        const auto &targets = map.at(uid);
+        AdjacencyRecord rec;
+        rec.uid = uid;
+        rec.target_offset = target_offset;
+        rec.target_count = targets.size();
+        writer.write_record(rec);
+        target_offset += targets.size();
+    }
+
+    std::vector<uint64_t> sorted_targets;
+    for (SymbolUID uid : keys) {
+        const auto &targets = map.at(uid);
+        sorted_targets.assign(targets.begin(), targets.end());
+        std::sort(sorted_targets.begin(), sorted_targets.end());
+        writer.write(sorted_targets.data(), sorted_targets.size() * sizeof(uint64_t));
+    }
+
+    writer.end_section(keys.size());
+}
+
+} // namespace
+
+void save_binary_index(const Graph &graph, const std::string &filepath) {
+    std::ofstream file(filepath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file for writing: " + filepath);
+    }
+
+    const CallGraph &cg = graph.call_graph;
+    constexpr uint32_t SECTION_COUNT = 11;
+
+    SectionWriter writer(file);
+    writer.reserve_layout(SECTION_COUNT);
+
+    // Symbol table + string pool. Records are sorted by UID so readers can
+    // binary-search the mapping directly.
+    {
+        std::vector<std::pair<SymbolUID, const std::string *>> symbols;
+        symbols.reserve(cg.symbol_to_uid.size());
+        for (const auto &[name, uid] : cg.symbol_to_uid) {
+            symbols.emplace_back(uid, &name);
+        }
+        std::sort(symbols.begin(), symbols.end());
+
+        writer.begin_section(SectionId::SymbolTable);
+        uint64_t name_offset = 0;
+        for (const auto &[uid, name] : symbols) {
+            SymbolRecord rec;
+            rec.uid = uid;
+            rec.name_offset = name_offset;
+            rec.name_len = static_cast<uint32_t>(name->size());
+            rec.type = static_cast<uint32_t>(cg.get_type(uid));
+            writer.write_record(rec);
+            name_offset += name->size();
+        }
+        writer.end_section(symbols.size());
+
+        writer.begin_section(SectionId::SymbolPool);
+        for (const auto &[uid, name] : symbols) {
+            writer.write(name->data(), name->size());
+        }
+        writer.end_section(symbols.size());
+    }
+
+    write_adjacency_section(writer, SectionId::CallMap, cg.call_map);
+    write_adjacency_section(writer, SectionId::ReverseCallMap, cg.reverse_call_map);
+    write_adjacency_section(writer, SectionId::DataFlowMap, cg.data_flow_map);
+    write_adjacency_section(writer, SectionId::ReverseDataFlowMap, cg.reverse_data_flow_map);
+
+    // File path table + string pool, sorted by file UID.
+    {
+        std::vector<std::pair<SymbolUID, size_t>> paths(cg.file_uid_to_path_idx.begin(),
+                                                        cg.file_uid_to_path_idx.end());
+        std::sort(paths.begin(), paths.end());
+
+        writer.begin_section(SectionId::FilePathTable);
+        uint64_t path_offset = 0;
+        for (const auto &[file_uid, path_idx] : paths) {
+            const std::string &path = cg.filepath_pool.get(path_idx);
+            FilePathRecord rec;
+            rec.file_uid = file_uid;
+            rec.path_offset = path_offset;
+            rec.path_len = static_cast<uint32_t>(path.size());
+            rec.reserved = 0;
+            writer.write_record(rec);
+            path_offset += path.size();
+        }
+        writer.end_section(paths.size());
+
+        writer.begin_section(SectionId::FilePathPool);
+        for (const auto &[file_uid, path_idx] : paths) {
+            const std::string &path = cg.filepath_pool.get(path_idx);
+            writer.write(path.data(), path.size());
+        }
+        writer.end_section(paths.size());
+    }
+
+    // File -> symbols adjacency.
+    {
+        writer.begin_section(SectionId::FileSymbols);
+        std::vector<SymbolUID> keys;
+        keys.reserve(cg.file_to_symbols.size());
+        for (const auto &[file_uid, symbols] : cg.file_to_symbols) {
+            keys.push_back(file_uid);
+        }
+        std::sort(keys.begin(), keys.end());
+
+        uint64_t target_offset = 0;
+        for (SymbolUID file_uid : keys) {
+            const auto &symbols = cg.file_to_symbols.at(file_uid);
+            AdjacencyRecord rec;
+            rec.uid = file_uid;
+            rec.target_offset = target_offset;
+            rec.target_count = symbols.size();
+            writer.write_record(rec);
+            target_offset += symbols.size();
+        }
+        for (SymbolUID file_uid : keys) {
+            const auto &symbols = cg.file_to_symbols.at(file_uid);
+            writer.write(symbols.data(), symbols.size() * sizeof(SymbolUID));
+        }
+        writer.end_section(keys.size());
+    }
+
+    // Symbol -> file pairs, sorted by symbol UID.
+    {
+        std::vector<SymbolFileRecord> records;
+        records.reserve(cg.symbol_to_file.size());
+        for (const auto &[symbol_uid, file_uid] : cg.symbol_to_file) {
+            records.push_back({symbol_uid, file_uid});
+        }
+        std::sort(records.begin(), records.end(),
+                  [](const SymbolFileRecord &a, const SymbolFileRecord &b) {
+                      return a.symbol_uid < b.symbol_uid;
+                  });
+
+        writer.begin_section(SectionId::SymbolFiles);
+        writer.write(records.data(), records.size() * sizeof(SymbolFileRecord));
+        writer.end_section(records.size());
+    }
+
+    // File metadata (mtime + content hash), sorted by file UID.
+    {
+        std::vector<FileMetaRecord> records;
+        records.reserve(cg.file_meta.size());
+        for (const auto &[file_uid, meta] : cg.file_meta) {
+            records.push_back({file_uid, meta.mtime, meta.hash});
+        }
+        std::sort(records.begin(), records.end(),
+                  [](const FileMetaRecord &a, const FileMetaRecord &b) {
+                      return a.file_uid < b.file_uid;
+                  });
+
+        writer.begin_section(SectionId::FileMeta);
+        writer.write(records.data(), records.size() * sizeof(FileMetaRecord));
+        writer.end_section(records.size());
+    }
+
+    // Back-patch header and section table now that offsets are known.
+    BinaryIndexHeader header;
+    std::memcpy(header.magic, BINARY_INDEX_MAGIC, sizeof(header.magic));
+    header.version = BINARY_INDEX_VERSION;
+    header.section_count = SECTION_COUNT;
+    header.end_uid = cg.end_uid;
+    header.next_uid = cg.next_uid;
+    header.next_file_uid = cg.next_file_uid;
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(writer.entries().data()),
+               static_cast<std::streamsize>(writer.entries().size() * sizeof(SectionEntry)));
+    if (!file) {
+        throw std::runtime_error("Failed to write binary index: " + filepath);
+    }
+}
+
+void BinaryIndex::open(const std::string &filepath) {
+    if (!mmap_.open(filepath)) {
+        throw std::runtime_error("Failed to open binary index: " + filepath);
+    }
+
+    if (mmap_.size() < sizeof(BinaryIndexHeader)) {
+        throw std::runtime_error("Binary index truncated: " + filepath);
+    }
+
+    const auto &hdr = header();
+    if (std::memcmp(hdr.magic, BINARY_INDEX_MAGIC, sizeof(hdr.magic)) != 0) {
+        throw std::runtime_error("Not a pioneer binary index: " + filepath);
+    }
+    if (hdr.version != BINARY_INDEX_VERSION) {
+        throw std::runtime_error("Binary index version " + std::to_string(hdr.version) +
+                                 " is not supported. Please re-index.");
+    }
+    if (mmap_.size() < sizeof(BinaryIndexHeader) + hdr.section_count * sizeof(SectionEntry)) {
+        throw std::runtime_error("Binary index truncated: " + filepath);
+    }
+}
+
+const BinaryIndexHeader &BinaryIndex::header() const {
+    return *reinterpret_cast<const BinaryIndexHeader *>(mmap_.data());
+}
+
+const SectionEntry *BinaryIndex::find_section(SectionId id) const {
+    const auto *entries =
+        reinterpret_cast<const SectionEntry *>(mmap_.data() + sizeof(BinaryIndexHeader));
+    for (uint32_t i = 0; i < header().section_count; ++i) {
+        if (entries[i].id == static_cast<uint32_t>(id)) {
+            return &entries[i];
+        }
+    }
+    return nullptr;
+}
+
+const char *BinaryIndex::section_data(const SectionEntry &entry) const {
+    if (entry.offset + entry.size > mmap_.size()) {
+        throw std::runtime_error("Binary index section out of bounds");
+    }
+    return mmap_.data() + entry.offset;
+}
+
+const SymbolRecord *BinaryIndex::symbols(uint64_t &count) const {
+    const SectionEntry *entry = find_section(SectionId::SymbolTable);
+    if (!entry) {
+        count = 0;
+        return nullptr;
+    }
+    count = entry->count;
+    return reinterpret_cast<const SymbolRecord *>(section_data(*entry));
+}
+
+const AdjacencyRecord *BinaryIndex::adjacency(SectionId id, uint64_t &count,
+                                              const uint64_t *&targets) const {
+    const SectionEntry *entry = find_section(id);
+    if (!entry) {
+        count = 0;
+        targets = nullptr;
+        return nullptr;
+    }
+    count = entry->count;
+    const char *data = section_data(*entry);
+    targets = reinterpret_cast<const uint64_t *>(data + count * sizeof(AdjacencyRecord));
+    return reinterpret_cast<const AdjacencyRecord *>(data);
+}
+
+const FilePathRecord *BinaryIndex::file_paths(uint64_t &count) const {
+    const SectionEntry *entry = find_section(SectionId::FilePathTable);
+    if (!entry) {
+        count = 0;
+        return nullptr;
+    }
+    count = entry->count;
+    return reinterpret_cast<const FilePathRecord *>(section_data(*entry));
+}
+
+const SymbolFileRecord *BinaryIndex::symbol_files(uint64_t &count) const {
+    const SectionEntry *entry = find_section(SectionId::SymbolFiles);
+    if (!entry) {
+        count = 0;
+        return nullptr;
+    }
+    count = entry->count;
+    return reinterpret_cast<const SymbolFileRecord *>(section_data(*entry));
+}
+
+const FileMetaRecord *BinaryIndex::file_meta(uint64_t &count) const {
+    const SectionEntry *entry = find_section(SectionId::FileMeta);
+    if (!entry) {
+        count = 0;
+        return nullptr;
+    }
+    count = entry->count;
+    return reinterpret_cast<const FileMetaRecord *>(section_data(*entry));
+}
+
+std::string_view BinaryIndex::symbol_name(const SymbolRecord &rec) const {
+    const SectionEntry *pool = find_section(SectionId::SymbolPool);
+    if (!pool) {
+        return {};
+    }
+    return std::string_view(section_data(*pool) + rec.name_offset, rec.name_len);
+}
+
+std::string_view BinaryIndex::file_path(const FilePathRecord &rec) const {
+    const SectionEntry *pool = find_section(SectionId::FilePathPool);
+    if (!pool) {
+        return {};
+    }
+    return std::string_view(section_data(*pool) + rec.path_offset, rec.path_len);
+}
+
+Graph BinaryIndex::to_graph(LoadMode mode) const { return to_graph(sections_for(mode)); }
+
+Graph BinaryIndex::to_graph(uint32_t sections) const {
+    Graph g;
+    CallGraph &cg = g.call_graph;
+
+    cg.end_uid = header().end_uid;
+    cg.next_uid = header().next_uid;
+    cg.next_file_uid = header().next_file_uid;
+
+    // Symbols are loaded in every mode, same as the SAX loader.
+    uint64_t symbol_count = 0;
+    const SymbolRecord *symbol_table = symbols(symbol_count);
+    cg.symbol_to_uid.reserve(symbol_count);
+    cg.uid_to_string_idx.reserve(symbol_count);
+    cg.symbol_types.reserve(symbol_count);
+    for (uint64_t i = 0; i < symbol_count; ++i) {
+        const SymbolRecord &rec = symbol_table[i];
+        std::string name(symbol_name(rec));
+        size_t str_idx = cg.symbol_pool.intern(name);
+        cg.symbol_to_uid[name] = rec.uid;
+        cg.uid_to_string_idx[rec.uid] = str_idx;
+        cg.set_symbol_type(rec.uid, static_cast<SymbolType>(rec.type));
+    }
+
+    auto load_adjacency =
+        [this](SectionId id, std::unordered_map<SymbolUID, std::unordered_set<SymbolUID>> &map) {
+            uint64_t count = 0;
+            const uint64_t *targets = nullptr;
+            const AdjacencyRecord *records = adjacency(id, count, targets);
+            map.reserve(count);
+            for (uint64_t i = 0; i < count; ++i) {
+                const AdjacencyRecord &rec = records[i];
+                auto &set = map[rec.uid];
+                set.reserve(rec.target_count);
+                for (uint64_t t = 0; t < rec.target_count; ++t) {
+                    set.insert(targets[rec.target_offset + t]);
+                }
+            }
+        };
+
+    if (sections & SectionCalls) {
+        load_adjacency(SectionId::CallMap, cg.call_map);
+    }
+    if (sections & SectionReverseCalls) {
+        load_adjacency(SectionId::ReverseCallMap, cg.reverse_call_map);
+    }
+    if (sections & SectionDataFlow) {
+        load_adjacency(SectionId::DataFlowMap, cg.data_flow_map);
+    }
+    if (sections & SectionReverseDataFlow) {
+        load_adjacency(SectionId::ReverseDataFlowMap, cg.reverse_data_flow_map);
+    }
+
+    if (sections & SectionFilePaths) {
+        uint64_t path_count = 0;
+        const FilePathRecord *path_table = file_paths(path_count);
+        cg.file_uid_to_path_idx.reserve(path_count);
+        cg.filepath_to_uid.reserve(path_count);
+        for (uint64_t i = 0; i < path_count; ++i) {
+            const FilePathRecord &rec = path_table[i];
+            std::string path(file_path(rec));
+            size_t path_idx = cg.filepath_pool.intern(path);
+            cg.file_uid_to_path_idx[rec.file_uid] = path_idx;
+            cg.filepath_to_uid[path] = rec.file_uid;
+        }
+
+        uint64_t fs_count = 0;
+        const uint64_t *fs_targets = nullptr;
+        const AdjacencyRecord *fs_records = adjacency(SectionId::FileSymbols, fs_count, fs_targets);
+        cg.file_to_symbols.reserve(fs_count);
+        for (uint64_t i = 0; i < fs_count; ++i) {
+            const AdjacencyRecord &rec = fs_records[i];
+            cg.file_to_symbols[rec.uid].assign(fs_targets + rec.target_offset,
+                                               fs_targets + rec.target_offset + rec.target_count);
+        }
+
+        uint64_t sf_count = 0;
+        const SymbolFileRecord *sf_records = symbol_files(sf_count);
+        cg.symbol_to_file.reserve(sf_count);
+        for (uint64_t i = 0; i < sf_count; ++i) {
+            cg.symbol_to_file[sf_records[i].symbol_uid] = sf_records[i].file_uid;
+        }
+    }
+
+    if (sections & SectionFileMeta) {
+        uint64_t meta_count = 0;
+        const FileMetaRecord *meta_records = file_meta(meta_count);
+        cg.file_meta.reserve(meta_count);
+        for (uint64_t i = 0; i < meta_count; ++i) {
+            cg.file_meta[meta_records[i].file_uid] = {meta_records[i].mtime,
+                                                      meta_records[i].hash};
+        }
+    }
+
+    cg.shrink_to_fit();
+    if (sections & SECTIONS_ADJACENCY) {
+        cg.build_csr();
+    }
+    return g;
+}
+
+Graph load_binary_index(const std::string &filepath, LoadMode mode) {
+    return load_binary_index(filepath, sections_for(mode));
+}
+
+Graph load_binary_index(const std::string &filepath, uint32_t sections) {
+    prof::ScopedTimer timer("load.binary_index");
+    BinaryIndex index;
+    index.open(filepath);
+    return index.to_graph(sections);
+}
+
+} // namespace pioneer
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "pioneer/commands.hpp"
+#include "pioneer/binary_index.hpp"
 #include "pioneer/indexer.hpp"
 #include "pioneer/query.hpp"
 #include "pioneer/streaming.hpp"
@@ -22,12 +23,11 @@
 #include <mutex>
 #include <regex>
 #include <set>
+#include <span>
 #include <thread>
 
 namespace pioneer {
 
-constexpr const char *INDEX_FILE = ".pioneer.json";
-
 // Grep match result structure
 struct GrepMatch {
     std::string filepath;
@@ -36,22 +36,101 @@ struct GrepMatch {
 };
 
 // Helper function to load the graph from index file (full load)
-bool load_graph(Graph &graph) {
-    try {
-        graph = Graph::load(INDEX_FILE);
-        return true;
-    } catch (const std::exception &e) {
-        std::cerr << "Error loading index: " << e.what() << std::endl;
-        std::cerr << "Please run 'pioneer --index' first." << std::endl;
+bool load_graph(Graph &graph) { return load_graph(graph, LoadMode::Full); }
+
+// Helper function to load graph with specific mode. Prefers the binary
+// index (memory-mapped, no JSON parse) and falls back to the JSON index
+// for trees indexed by older versions.
+bool load_graph(Graph &graph, LoadMode mode) { return load_graph(graph, sections_for(mode)); }
+
+static std::vector<std::string> g_federated_indexes;
+
+void set_federated_indexes(const std::vector<std::string> &paths) { g_federated_indexes = paths; }
+
+// Load one federated shard with the same section mask as the primary
+// index; binary shards are picked by extension, everything else goes
+// through the JSON loader (which handles zstd and plain files).
+static Graph load_shard_index(const std::string &path, uint32_t sections) {
+    if (path.size() >= 4 && path.compare(path.size() - 4, 4, ".idx") == 0) {
+        return load_binary_index(path, sections);
+    }
+    return Graph::load(path, sections);
+}
+
+// Merge every --with-index shard into the loaded graph. Shards load in
+// parallel (independent files); merging runs serially in the order given
+// so UID assignment stays deterministic across runs.
+static bool merge_federated_indexes(Graph &graph, uint32_t sections) {
+    std::vector<Graph> shards(g_federated_indexes.size());
+    std::vector<std::string> errors(g_federated_indexes.size());
+    std::vector<std::thread> loaders;
+    loaders.reserve(g_federated_indexes.size());
+    for (size_t i = 0; i < g_federated_indexes.size(); ++i) {
+        loaders.emplace_back([&, i] {
+            try {
+                shards[i] = load_shard_index(g_federated_indexes[i], sections);
+            } catch (const std::exception &e) {
+                errors[i] = e.what();
+            }
+        });
+    }
+    for (auto &loader : loaders) {
+        loader.join();
+    }
+
+    for (size_t i = 0; i < shards.size(); ++i) {
+        if (!errors[i].empty()) {
+            std::cerr << "Error loading shard index " << g_federated_indexes[i] << ": "
+                      << errors[i] << std::endl;
+            return false;
+        }
+        graph.merge(shards[i]);
+    }
+
+    // Cross-shard edges resolved by name during the merges invalidate the
+    // per-shard packed adjacency; rebuild once over the federated graph
+    if (sections & SECTIONS_ADJACENCY) {
+        graph.call_graph.build_csr();
+    }
+    return true;
+}
+
+// The binary index is derived from the JSON index, so prefer it only when
+// it is at least as new: if an --index run failed or was interrupted after
+// republishing the JSON but before the binary, the stale binary must not
+// shadow the fresh results.
+static bool binary_index_current() {
+    std::error_code ec;
+    if (!fs::exists(BINARY_INDEX_FILE, ec) || ec) {
         return false;
     }
+    auto bin_time = fs::last_write_time(BINARY_INDEX_FILE, ec);
+    if (ec) {
+        return false;
+    }
+    auto json_time = fs::last_write_time(INDEX_FILE, ec);
+    if (ec) {
+        return true; // no JSON index to fall back to
+    }
+    return bin_time >= json_time;
 }
 
-// Helper function to load graph with specific mode
-bool load_graph(Graph &graph, LoadMode mode) {
+// Section-mask variant: commands that know their access pattern request
+// just the sections they traverse instead of a full load.
+bool load_graph(Graph &graph, uint32_t sections) {
+    if (binary_index_current()) {
+        try {
+            graph = load_binary_index(BINARY_INDEX_FILE, sections);
+            return g_federated_indexes.empty() || merge_federated_indexes(graph, sections);
+        } catch (const std::exception &e) {
+            std::cerr << "Warning: failed to load binary index: " << e.what() << std::endl;
+            std::cerr << "Falling back to " << INDEX_FILE << "." << std::endl;
+        }
+    }
+
     try {
-        graph = Graph::load(INDEX_FILE, mode);
-        return true;
+        graph = Graph::load(INDEX_FILE, sections);
+        return g_federated_indexes.empty() || merge_federated_indexes(graph, sections);
     } catch (const std::exception &e) {
         std::cerr << "Error loading index: " << e.what() << std::endl;
         std::cerr << "Please run 'pioneer --index' first." << std::endl;
@@ -100,7 +179,7 @@ const char *symbol_type_to_string(SymbolType type) {
     }
 }
 
-int cmd_index(unsigned int num_threads) {
+int cmd_index(unsigned int num_threads, bool incremental) {
     std::cout << "Indexing current directory..." << std::endl;
 
     IndexerConfig config;
@@ -109,20 +188,66 @@ int cmd_index(unsigned int num_threads) {
     config.num_threads = num_threads;
 
     Indexer indexer(config);
-    Graph graph = indexer.index();
 
+    // For incremental runs, start from the previous index when one exists;
+    // a missing or unreadable index just degrades to a full re-index.
+    Graph previous;
+    if (incremental) {
+        if (fs::exists(BINARY_INDEX_FILE) || fs::exists(INDEX_FILE)) {
+            if (!load_graph(previous, LoadMode::Full)) {
+                previous = Graph{};
+            }
+        }
+        if (previous.call_graph.file_meta.empty()) {
+            std::cout << "No previous index with file metadata - performing full index."
+                      << std::endl;
+        }
+    }
+
+    Graph graph = indexer.index(std::move(previous));
+
+    // Write-to-temp plus rename publishes each index atomically (the same
+    // scheme the watch daemon uses to republish), so an interrupted run
+    // never leaves a partial index and a reader always sees either the old
+    // or the new file
     try {
-        graph.save(INDEX_FILE);
+        const std::string json_tmp = std::string(INDEX_FILE) + ".tmp";
+        graph.save(json_tmp);
+        fs::rename(json_tmp, INDEX_FILE);
         std::cout << "\nIndex saved to: " << INDEX_FILE << std::endl;
     } catch (const std::exception &e) {
         std::cerr << "Error saving index: " << e.what() << std::endl;
         return 1;
     }
 
+    try {
+        const std::string idx_tmp = std::string(BINARY_INDEX_FILE) + ".tmp";
+        save_binary_index(graph, idx_tmp);
+        fs::rename(idx_tmp, BINARY_INDEX_FILE);
+        std::cout << "Binary index saved to: " << BINARY_INDEX_FILE << std::endl;
+    } catch (const std::exception &e) {
+        // Loaders fall back to the fresher JSON while the binary is stale
+        std::cerr << "Error saving binary index: " << e.what() << std::endl;
+        return 1;
+    }
+
     return 0;
 }
 
 int cmd_search_streaming(const std::vector<std::string> &patterns, bool nosort) {
+    // A SymbolsOnly load of the binary index feeds the trigram-backed search,
+    // which is both faster and lighter than re-streaming the JSON per query.
+    // The SAX path below remains the fallback for JSON-only indexes.
+    if (binary_index_current()) {
+        try {
+            Graph graph = load_binary_index(BINARY_INDEX_FILE, LoadMode::SymbolsOnly);
+            return cmd_search(patterns, nosort, false, graph);
+        } catch (const std::exception &e) {
+            std::cerr << "Error reading " << BINARY_INDEX_FILE << ": " << e.what() << std::endl;
+            std::cerr << "Falling back to " << INDEX_FILE << "." << std::endl;
+        }
+    }
+
     try {
         auto matches = stream_search_symbols(INDEX_FILE, patterns);
 
@@ -166,6 +291,65 @@ int cmd_list_symbols_streaming(bool nosort) {
     }
 }
 
+int cmd_stats() {
+    // The stats section lives in the metadata header the writer emits before
+    // the UIDs table, so this decompresses O(header) bytes no matter how
+    // large the graph is. Indexes written before the section carry only the
+    // basic counts.
+    json meta;
+    try {
+        meta = stream_index_metadata(INDEX_FILE);
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::cerr << "Please run 'pioneer --index' first." << std::endl;
+        return 1;
+    }
+
+    std::cout << "Index statistics:" << std::endl;
+    std::cout << "  Symbols:   " << meta.value("num_symbols", uint64_t{0}) << std::endl;
+    std::cout << "  Functions: " << meta.value("num_functions", uint64_t{0}) << std::endl;
+    std::cout << "  Variables: " << meta.value("num_variables", uint64_t{0}) << std::endl;
+    std::cout << "  Files:     " << meta.value("num_files", uint64_t{0}) << std::endl;
+
+    if (!meta.contains("stats")) {
+        std::cout << "  (re-index for edge counts and the degree histogram)" << std::endl;
+        return 0;
+    }
+    const json &stats = meta["stats"];
+    std::cout << "  Call edges:      " << stats.value("num_call_edges", uint64_t{0}) << std::endl;
+    std::cout << "  Data-flow edges: " << stats.value("num_data_flow_edges", uint64_t{0})
+              << std::endl;
+
+    if (stats.contains("files_by_language")) {
+        std::cout << "  Files by language:" << std::endl;
+        for (const auto &[lang, count] : stats["files_by_language"].items()) {
+            std::cout << "    " << lang << ": " << count.get<uint64_t>() << std::endl;
+        }
+    }
+
+    if (stats.contains("degree_histogram")) {
+        const auto &histogram = stats["degree_histogram"];
+        std::cout << "  Call degree histogram:" << std::endl;
+        for (size_t bucket = 0; bucket < histogram.size(); ++bucket) {
+            uint64_t count = histogram[bucket].get<uint64_t>();
+            if (count == 0) {
+                continue;
+            }
+            // Bucket 0 holds isolated symbols, bucket k degrees in [2^(k-1), 2^k)
+            uint64_t lo = bucket == 0 ? 0 : uint64_t{1} << (bucket - 1);
+            uint64_t hi = (uint64_t{1} << bucket) - 1;
+            if (bucket == histogram.size() - 1) {
+                std::cout << "    " << lo << "+: " << count << std::endl;
+            } else if (lo == hi) {
+                std::cout << "    " << lo << ": " << count << std::endl;
+            } else {
+                std::cout << "    " << lo << "-" << hi << ": " << count << std::endl;
+            }
+        }
+    }
+    return 0;
+}
+
 int cmd_grep_streaming(const std::string &pattern, unsigned int num_threads, bool use_regex,
                        bool ignore_case) {
     std::vector<std::string> files;
@@ -275,7 +459,16 @@ int cmd_grep_streaming(const std::string &pattern, unsigned int num_threads, boo
 
 int cmd_search(const std::vector<std::string> &patterns, const bool nosort, const bool show_path,
                const Graph &graph) {
+    return cmd_search(patterns, nosort, show_path, "", graph);
+}
+
+int cmd_search(const std::vector<std::string> &patterns, const bool nosort, const bool show_path,
+               const std::string &scope, const Graph &graph) {
     QueryEngine engine(graph);
+    if (!engine.set_scope(scope)) {
+        std::cerr << "Error: No indexed files under directory: " << scope << std::endl;
+        return 1;
+    }
     auto matches = engine.find_symbols(patterns);
 
     if (!nosort) {
@@ -309,12 +502,53 @@ int cmd_search(const std::vector<std::string> &patterns, const bool nosort, cons
 
 int cmd_query(const std::vector<std::string> &start_chain,
               const std::vector<std::string> &end_chain, bool backtrace, bool pattern_match,
-              bool nosort, bool show_path) {
+              bool nosort, bool show_path, size_t shortest_k, uint32_t exclude_hubs,
+              const std::string &scope) {
     Graph graph;
-    if (!load_graph(graph))
+
+    // Load only the adjacency this query direction traverses: a backtrace
+    // walks the reverse map, a forward trace the forward map, and only
+    // start-to-end queries (bidirectional pruning, k-shortest) need both.
+    bool is_backtrace = backtrace || (!start_chain.empty() && start_chain[0] == "START");
+    bool is_forward = !end_chain.empty() && end_chain[0] == "END";
+    uint32_t sections;
+    if (is_backtrace) {
+        sections = SectionReverseCalls;
+    } else if (is_forward) {
+        sections = SectionCalls;
+    } else {
+        sections = SectionCalls | SectionReverseCalls;
+    }
+    if (show_path) {
+        sections |= SectionFilePaths;
+    }
+    // Hub degrees are caller + callee counts, so pruning needs both
+    // adjacency directions even for one-directional traversals
+    if (exclude_hubs != 0) {
+        sections |= SectionCalls | SectionReverseCalls;
+    }
+    // Directory scoping resolves through the file-path tables
+    if (!scope.empty()) {
+        sections |= SectionFilePaths;
+    }
+
+    if (!load_graph(graph, sections))
         return 1;
 
+    return cmd_query(start_chain, end_chain, backtrace, pattern_match, nosort, show_path,
+                     shortest_k, exclude_hubs, scope, graph);
+}
+
+int cmd_query(const std::vector<std::string> &start_chain,
+              const std::vector<std::string> &end_chain, bool backtrace, bool pattern_match,
+              bool nosort, bool show_path, size_t shortest_k, uint32_t exclude_hubs,
+              const std::string &scope, const Graph &graph) {
     QueryEngine engine(graph);
+    engine.set_hub_limit(exclude_hubs);
+    if (!engine.set_scope(scope)) {
+        std::cerr << "Error: No indexed files under directory: " << scope << std::endl;
+        return 1;
+    }
 
     // Handle special cases
     bool is_backtrace = backtrace || (!start_chain.empty() && start_chain[0] == "START");
@@ -408,33 +642,35 @@ int cmd_query(const std::vector<std::string> &start_chain,
     std::string query_start = start_resolved.empty() ? "START" : start_resolved.back();
     std::string query_end = end_resolved.empty() ? "END" : end_resolved.front();
 
+    // Chain prefix (all but last of start) and suffix (all but first of end)
+    // resolved to UIDs once, so per-path emission materializes no strings
+    std::vector<SymbolUID> fixed_prefix, fixed_suffix;
+    for (size_t i = 0; i + 1 < start_resolved.size(); ++i)
+        fixed_prefix.push_back(graph.get_uid(start_resolved[i]));
+    for (size_t i = 1; i < end_resolved.size(); ++i)
+        fixed_suffix.push_back(graph.get_uid(end_resolved[i]));
+
     size_t path_count = 0;
-    engine.find_paths(query_start, query_end, [&](const std::vector<std::string> &middle_path) {
+    std::vector<SymbolUID> full_path;
+    auto emit_path = [&](std::span<const SymbolUID> middle_path) {
         path_count++;
         std::cout << "[" << path_count << "] ";
 
         // Build full path: start_chain (except last) + middle_path + end_chain (except first)
-        std::vector<std::string> full_path;
-
-        // Add start_chain prefix (all but last, since middle_path starts with it)
-        for (size_t i = 0; i + 1 < start_resolved.size(); ++i)
-            full_path.push_back(start_resolved[i]);
-
-        // Add middle path
-        for (const auto &sym : middle_path)
-            full_path.push_back(sym);
+        full_path.clear();
+        full_path.insert(full_path.end(), fixed_prefix.begin(), fixed_prefix.end());
+        full_path.insert(full_path.end(), middle_path.begin(), middle_path.end());
+        full_path.insert(full_path.end(), fixed_suffix.begin(), fixed_suffix.end());
 
-        // Add end_chain suffix (all but first, since middle_path ends with it)
-        for (size_t i = 1; i < end_resolved.size(); ++i)
-            full_path.push_back(end_resolved[i]);
-
-        if (show_path) {
-            QueryEngine::print_path(full_path, graph, true);
-        } else {
-            QueryEngine::print_path(full_path);
-        }
+        QueryEngine::print_path(full_path, graph, show_path);
         return true;
-    });
+    };
+
+    if (shortest_k > 0) {
+        engine.find_shortest_paths(query_start, query_end, shortest_k, emit_path);
+    } else {
+        engine.find_paths(query_start, query_end, emit_path);
+    }
 
     if (path_count == 0)
         std::cout << "No paths found." << std::endl;
@@ -450,6 +686,10 @@ int cmd_list_symbols(const bool nosort) {
         return 1;
     }
 
+    return cmd_list_symbols(nosort, graph);
+}
+
+int cmd_list_symbols(const bool nosort, const Graph &graph) {
     const auto &symbol_map = graph.get_symbol_map();
 
     std::cout << "Symbols in index (" << symbol_map.size() << "):" << std::endl;
@@ -480,6 +720,10 @@ int cmd_type(const std::string &symbol, const bool nosort) {
         return 1;
     }
 
+    return cmd_type(symbol, nosort, graph);
+}
+
+int cmd_type(const std::string &symbol, const bool nosort, const Graph &graph) {
     QueryEngine engine(graph);
 
     if (!validate_symbol(engine, symbol, "Symbol", nosort)) {
@@ -496,10 +740,18 @@ int cmd_type(const std::string &symbol, const bool nosort) {
 
 int cmd_callers(const std::vector<std::string> &patterns, bool nosort, bool show_path) {
     Graph graph;
-    LoadMode mode = show_path ? LoadMode::WithPaths : LoadMode::Full;
-    if (!load_graph(graph, mode))
+    uint32_t sections = SectionReverseCalls;
+    if (show_path) {
+        sections |= SectionFilePaths;
+    }
+    if (!load_graph(graph, sections))
         return 1;
 
+    return cmd_callers(patterns, nosort, show_path, graph);
+}
+
+int cmd_callers(const std::vector<std::string> &patterns, bool nosort, bool show_path,
+                const Graph &graph) {
     QueryEngine engine(graph);
     auto matches = engine.find_symbols(patterns);
 
@@ -538,10 +790,18 @@ int cmd_callers(const std::vector<std::string> &patterns, bool nosort, bool show
 
 int cmd_callees(const std::vector<std::string> &patterns, bool nosort, bool show_path) {
     Graph graph;
-    LoadMode mode = show_path ? LoadMode::WithPaths : LoadMode::Full;
-    if (!load_graph(graph, mode))
+    uint32_t sections = SectionCalls;
+    if (show_path) {
+        sections |= SectionFilePaths;
+    }
+    if (!load_graph(graph, sections))
         return 1;
 
+    return cmd_callees(patterns, nosort, show_path, graph);
+}
+
+int cmd_callees(const std::vector<std::string> &patterns, bool nosort, bool show_path,
+                const Graph &graph) {
     QueryEngine engine(graph);
     auto matches = engine.find_symbols(patterns);
 
@@ -580,9 +840,13 @@ int cmd_callees(const std::vector<std::string> &patterns, bool nosort, bool show
 
 int cmd_data_sources(const std::vector<std::string> &patterns, bool nosort) {
     Graph graph;
-    if (!load_graph(graph))
+    if (!load_graph(graph, SectionReverseDataFlow))
         return 1;
 
+    return cmd_data_sources(patterns, nosort, graph);
+}
+
+int cmd_data_sources(const std::vector<std::string> &patterns, bool nosort, const Graph &graph) {
     QueryEngine engine(graph);
     auto matches = engine.find_symbols(patterns);
 
@@ -607,9 +871,13 @@ int cmd_data_sources(const std::vector<std::string> &patterns, bool nosort) {
 
 int cmd_data_sinks(const std::vector<std::string> &patterns, bool nosort) {
     Graph graph;
-    if (!load_graph(graph))
+    if (!load_graph(graph, SectionDataFlow))
         return 1;
 
+    return cmd_data_sinks(patterns, nosort, graph);
+}
+
+int cmd_data_sinks(const std::vector<std::string> &patterns, bool nosort, const Graph &graph) {
     QueryEngine engine(graph);
     auto matches = engine.find_symbols(patterns);
 
@@ -634,9 +902,14 @@ int cmd_data_sinks(const std::vector<std::string> &patterns, bool nosort) {
 
 int cmd_list_variables(const std::vector<std::string> &patterns, bool nosort) {
     Graph graph;
-    if (!load_graph(graph))
+    // Pure symbol-table scan; no adjacency needed
+    if (!load_graph(graph, SECTIONS_NONE))
         return 1;
 
+    return cmd_list_variables(patterns, nosort, graph);
+}
+
+int cmd_list_variables(const std::vector<std::string> &patterns, bool nosort, const Graph &graph) {
     QueryEngine engine(graph);
 
     // Get variables matching first pattern, then narrow down
@@ -664,9 +937,14 @@ int cmd_list_variables(const std::vector<std::string> &patterns, bool nosort) {
 
 int cmd_find_member(const std::vector<std::string> &patterns, bool nosort) {
     Graph graph;
-    if (!load_graph(graph))
+    // Symbol-table scan plus the assignment sources for each match
+    if (!load_graph(graph, SectionReverseDataFlow))
         return 1;
 
+    return cmd_find_member(patterns, nosort, graph);
+}
+
+int cmd_find_member(const std::vector<std::string> &patterns, bool nosort, const Graph &graph) {
     QueryEngine engine(graph);
     std::vector<std::string> matches;
 
@@ -711,6 +989,166 @@ int cmd_find_member(const std::vector<std::string> &patterns, bool nosort) {
     return 0;
 }
 
+int cmd_reachable(const std::vector<std::string> &symbols) {
+    Graph graph;
+    // Condensation and closure both run over the forward map only
+    if (!load_graph(graph, SectionCalls))
+        return 1;
+
+    return cmd_reachable(symbols, graph);
+}
+
+int cmd_reachable(const std::vector<std::string> &symbols, const Graph &graph) {
+    if (symbols.size() < 2) {
+        std::cerr << "Error: --reachable needs a source and at least one target "
+                     "(comma-separated)"
+                  << std::endl;
+        return 1;
+    }
+
+    QueryEngine engine(graph);
+    const std::string &source = symbols[0];
+    if (!validate_symbol(engine, source, "Source", false))
+        return 1;
+
+    std::cout << "Reachable from " << source << ":" << std::endl;
+    for (size_t i = 1; i < symbols.size(); ++i) {
+        if (!engine.has_symbol(symbols[i])) {
+            std::cout << "  [?]   " << symbols[i] << " (not in index)" << std::endl;
+            continue;
+        }
+        bool reachable = engine.is_reachable(source, symbols[i]);
+        std::cout << (reachable ? "  [yes] " : "  [no]  ") << symbols[i] << std::endl;
+    }
+    return 0;
+}
+
+// Run one parsed batch query against the resident engine and return its
+// result object. Unknown ops and missing symbols come back as {"error": ...}
+// so one bad line never aborts the batch.
+static json run_batch_query(QueryEngine &engine, const Graph &graph, const json &request) {
+    json response;
+    std::string op = request.value("op", "");
+    response["op"] = op;
+
+    if (op == "paths") {
+        std::string start = request.value("start", "START");
+        std::string end = request.value("end", "END");
+        response["start"] = start;
+        response["end"] = end;
+        if (start != "START" && !graph.has_symbol(start)) {
+            response["error"] = "symbol not found: " + start;
+            return response;
+        }
+        if (end != "END" && !graph.has_symbol(end)) {
+            response["error"] = "symbol not found: " + end;
+            return response;
+        }
+        json paths = json::array();
+        engine.find_paths(start, end, [&](const std::vector<std::string> &path) {
+            paths.push_back(path);
+            return true;
+        });
+        response["paths"] = std::move(paths);
+        return response;
+    }
+
+    if (op == "reachable") {
+        std::string start = request.value("start", "");
+        std::string end = request.value("end", "");
+        response["start"] = start;
+        response["end"] = end;
+        if (!graph.has_symbol(start)) {
+            response["error"] = "symbol not found: " + start;
+            return response;
+        }
+        if (!graph.has_symbol(end)) {
+            response["error"] = "symbol not found: " + end;
+            return response;
+        }
+        response["reachable"] = engine.is_reachable(start, end);
+        return response;
+    }
+
+    if (op == "search") {
+        std::string pattern = request.value("pattern", "");
+        response["pattern"] = pattern;
+        auto matches = engine.find_symbols(pattern);
+        std::sort(matches.begin(), matches.end());
+        response["matches"] = matches;
+        return response;
+    }
+
+    std::string symbol = request.value("symbol", "");
+    response["symbol"] = symbol;
+
+    if (op == "callers" || op == "callees" || op == "data-sources" || op == "data-sinks" ||
+        op == "type") {
+        if (!graph.has_symbol(symbol)) {
+            response["error"] = "symbol not found: " + symbol;
+            return response;
+        }
+    }
+
+    if (op == "callers") {
+        auto callers = engine.immediate_callers(symbol);
+        std::sort(callers.begin(), callers.end());
+        response["callers"] = callers;
+    } else if (op == "callees") {
+        auto callees = engine.immediate_callees(symbol);
+        std::sort(callees.begin(), callees.end());
+        response["callees"] = callees;
+    } else if (op == "data-sources") {
+        auto sources = engine.data_sources(symbol);
+        std::sort(sources.begin(), sources.end());
+        response["sources"] = sources;
+    } else if (op == "data-sinks") {
+        auto sinks = engine.data_sinks(symbol);
+        std::sort(sinks.begin(), sinks.end());
+        response["sinks"] = sinks;
+    } else if (op == "type") {
+        response["type"] = symbol_type_to_string(graph.call_graph.get_type(graph.get_uid(symbol)));
+    } else {
+        response["error"] = "unknown op: " + op;
+    }
+    return response;
+}
+
+int cmd_batch(const std::string &queries_file) {
+    std::ifstream in(queries_file);
+    if (!in.is_open()) {
+        std::cerr << "Error: failed to open query file: " << queries_file << std::endl;
+        return 1;
+    }
+
+    // One load amortized over the whole batch - load time dominates
+    // individual queries by orders of magnitude.
+    Graph graph;
+    if (!load_graph(graph))
+        return 1;
+
+    QueryEngine engine(graph);
+
+    std::string line;
+    size_t line_num = 0;
+    while (std::getline(in, line)) {
+        ++line_num;
+        if (line.empty())
+            continue;
+
+        json response;
+        try {
+            json request = json::parse(line);
+            response = run_batch_query(engine, graph, request);
+        } catch (const std::exception &e) {
+            response = {{"line", line_num}, {"error", std::string("invalid query: ") + e.what()}};
+        }
+        std::cout << response.dump() << "\n";
+    }
+    std::cout.flush();
+    return 0;
+}
+
 // Multithreaded grep functionality (old implementation - kept for reference)
 static void grep_worker(const std::vector<std::string> &files, size_t start_idx, size_t end_idx,
                         const std::string &pattern, bool use_regex, bool ignore_case,
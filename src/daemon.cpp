@@ -0,0 +1,566 @@
+// Copyright 2025 Siddhant Biradar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pioneer/daemon.hpp"
+#include "pioneer/binary_index.hpp"
+#include "pioneer/commands.hpp"
+#include "pioneer/indexer.hpp"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <cxxopts.hpp>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace pioneer {
+
+namespace {
+
+volatile std::sig_atomic_t g_stop_requested = 0;
+
+void handle_signal(int /*signum*/) { g_stop_requested = 1; }
+
+// Editors write several files in a burst (save-all, format-on-save, git
+// checkout); waiting for this quiet period batches the burst into one
+// incremental re-index instead of one per save event.
+constexpr int WATCH_DEBOUNCE_MS = 200;
+
+// Recursive inotify watcher over the source tree, filtered by the same
+// ignore rules the indexer applies during discovery. inotify watches are
+// per-directory, so the whole tree is walked once at startup and
+// directories created later are added as their creation events arrive.
+class TreeWatcher {
+public:
+
+    bool init(const IndexerConfig &config) {
+        fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd_ < 0)
+            return false;
+        rules_ = std::make_unique<Indexer>(config);
+        add_directory(config.root_path);
+        return true;
+    }
+
+    ~TreeWatcher() {
+        if (fd_ >= 0)
+            ::close(fd_);
+    }
+
+    int fd() const { return fd_; }
+
+    // Drain every queued event. Returns true when any watched source file
+    // was written, created, deleted or moved - i.e. a re-index is due.
+    bool drain() {
+        bool source_changed = false;
+        alignas(inotify_event) char buffer[16 * 1024];
+        for (;;) {
+            ssize_t n = ::read(fd_, buffer, sizeof(buffer));
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                break; // EAGAIN: queue drained
+            }
+            if (n == 0)
+                break;
+
+            for (ssize_t offset = 0; offset < n;) {
+                const auto *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event)) + event->len;
+
+                if (event->mask & IN_IGNORED) {
+                    watched_.erase(event->wd); // kernel dropped the watch (dir deleted)
+                    continue;
+                }
+                auto it = watched_.find(event->wd);
+                if (it == watched_.end() || event->len == 0)
+                    continue;
+
+                fs::path full = it->second / event->name;
+                if (rules_->should_ignore(full))
+                    continue;
+
+                if (event->mask & IN_ISDIR) {
+                    // A moved-in directory can already hold source files by
+                    // the time the event arrives, so it counts as a change.
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                        add_directory(full);
+                    source_changed = true;
+                    continue;
+                }
+                if (language_from_extension(full.extension().string()) != Language::Unknown)
+                    source_changed = true;
+            }
+        }
+        return source_changed;
+    }
+
+private:
+
+    static constexpr uint32_t WATCH_MASK =
+        IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+
+    void add_directory(const fs::path &root) {
+        std::vector<fs::path> pending{root};
+        while (!pending.empty()) {
+            fs::path current = std::move(pending.back());
+            pending.pop_back();
+
+            int wd = ::inotify_add_watch(fd_, current.c_str(), WATCH_MASK);
+            if (wd < 0)
+                continue; // raced with a delete, or EMFILE - skip the subtree
+            watched_[wd] = current;
+
+            std::error_code ec;
+            fs::directory_iterator it(current, ec), end;
+            for (; !ec && it != end; it.increment(ec)) {
+                std::error_code type_ec;
+                if (it->is_directory(type_ec) && !type_ec && !rules_->should_ignore(it->path()))
+                    pending.push_back(it->path());
+            }
+        }
+    }
+
+    int fd_ = -1;
+    std::unique_ptr<Indexer> rules_;
+    std::unordered_map<int, fs::path> watched_;
+};
+
+// Re-parse whatever changed into the resident graph, then republish the
+// on-disk indexes atomically (write to a temp file, rename over the old
+// one) so a concurrent one-shot invocation never reads a partial index.
+void reindex_resident(Graph &graph, const IndexerConfig &config) {
+    Indexer indexer(config);
+    graph = indexer.index(std::move(graph));
+
+    // The path searches traverse derived structures, not the hash maps the
+    // re-index just mutated: rebuild the CSR mirrors (which also drops the
+    // cached condensation) and invalidate the path trie, or queries would
+    // keep answering from the pre-edit graph
+    graph.call_graph.build_csr();
+    graph.call_graph.path_trie_built = false;
+
+    try {
+        const std::string json_tmp = std::string(INDEX_FILE) + ".tmp";
+        graph.save(json_tmp);
+        fs::rename(json_tmp, INDEX_FILE);
+
+        const std::string idx_tmp = std::string(BINARY_INDEX_FILE) + ".tmp";
+        save_binary_index(graph, idx_tmp);
+        fs::rename(idx_tmp, BINARY_INDEX_FILE);
+    } catch (const std::exception &e) {
+        std::cerr << "Warning: failed to republish index: " << e.what() << std::endl;
+    }
+}
+
+bool write_all(int fd, const char *data, size_t len) {
+    size_t written = 0;
+    while (written < len) {
+        ssize_t n = ::write(fd, data + written, len - written);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Read one request from the client: one argument per line, terminated by an
+// empty line (or EOF).
+bool read_request(int fd, std::vector<std::string> &args) {
+    std::string buffer;
+    char chunk[4096];
+    for (;;) {
+        ssize_t n = ::read(fd, chunk, sizeof(chunk));
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        if (n == 0)
+            break;
+        buffer.append(chunk, static_cast<size_t>(n));
+        if (buffer == "\n" ||
+            (buffer.size() >= 2 && buffer.compare(buffer.size() - 2, 2, "\n\n") == 0))
+            break;
+    }
+
+    args.clear();
+    size_t pos = 0;
+    while (pos < buffer.size()) {
+        size_t nl = buffer.find('\n', pos);
+        if (nl == std::string::npos || nl == pos)
+            break; // empty line = end of request
+        args.emplace_back(buffer, pos, nl - pos);
+        pos = nl + 1;
+    }
+    return true;
+}
+
+int connect_to_daemon() {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, DAEMON_SOCKET_FILE, sizeof(addr.sun_path) - 1);
+
+    if (::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Dispatch one forwarded invocation against the resident graph. Mirrors the
+// query subset of the option table in main.cpp; index/grep/daemon control
+// never get forwarded here.
+int run_command(const std::vector<std::string> &args, const Graph &graph) {
+    cxxopts::Options options("pioneer", "Resident query dispatcher");
+
+    auto opts = options.add_options();
+    opts("s,start", "Start symbol chain", cxxopts::value<std::vector<std::string>>());
+    opts("e,end", "End symbol chain", cxxopts::value<std::vector<std::string>>());
+    opts("b,backtrace", "Enable backtrace mode");
+    opts("shortest", "Report only the k shortest paths",
+         cxxopts::value<size_t>()->default_value("0")->implicit_value("10"));
+    opts("exclude-hubs", "Skip symbols above this degree during path searches",
+         cxxopts::value<uint32_t>()->default_value("0"));
+    opts("scope", "Restrict searches to symbols under this directory",
+         cxxopts::value<std::string>()->default_value(""));
+    opts("l,list", "List all indexed symbols");
+    opts("caller", "Find immediate callers", cxxopts::value<std::vector<std::string>>());
+    opts("callee", "Find immediate callees", cxxopts::value<std::vector<std::string>>());
+    opts("data-sources", "Find data sources", cxxopts::value<std::vector<std::string>>());
+    opts("data-sinks", "Find data sinks", cxxopts::value<std::vector<std::string>>());
+    opts("vars", "List variables", cxxopts::value<std::vector<std::string>>());
+    opts("member", "Find member assignments", cxxopts::value<std::vector<std::string>>());
+    opts("reachable", "Check reachability from the first symbol to the rest",
+         cxxopts::value<std::vector<std::string>>());
+    opts("search", "Search symbols", cxxopts::value<std::vector<std::string>>());
+    opts("path", "Show file paths for symbols");
+    opts("p,pattern", "Pattern matching for --start and --end");
+    opts("nosort", "Do not sort the list of symbols");
+    opts("type", "Print type of symbol", cxxopts::value<std::string>()->default_value(""));
+    // Accepted so forwarded command lines parse; the report itself is
+    // client-side (the daemon did the load long ago anyway)
+    opts("profile", "Ignored in daemon mode",
+         cxxopts::value<std::string>()->default_value("")->implicit_value("text"));
+
+    std::vector<std::string> arg_storage = args;
+    std::vector<char *> argv;
+    std::string prog = "pioneer";
+    argv.push_back(prog.data());
+    for (auto &arg : arg_storage)
+        argv.push_back(arg.data());
+
+    auto result = options.parse(static_cast<int>(argv.size()), argv.data());
+
+    bool nosort = result.count("nosort") > 0;
+    bool show_path = result.count("path") > 0;
+    std::string scope = result["scope"].as<std::string>();
+
+    if (result.count("list"))
+        return cmd_list_symbols(nosort, graph);
+
+    if (result.count("type")) {
+        std::string type_symbol = result["type"].as<std::string>();
+        if (!type_symbol.empty())
+            return cmd_type(type_symbol, nosort, graph);
+    }
+
+    if (result.count("search")) {
+        auto patterns = result["search"].as<std::vector<std::string>>();
+        if (!patterns.empty())
+            return cmd_search(patterns, nosort, show_path, scope, graph);
+    }
+
+    if (result.count("caller")) {
+        auto patterns = result["caller"].as<std::vector<std::string>>();
+        if (!patterns.empty())
+            return cmd_callers(patterns, nosort, show_path, graph);
+    }
+
+    if (result.count("callee")) {
+        auto patterns = result["callee"].as<std::vector<std::string>>();
+        if (!patterns.empty())
+            return cmd_callees(patterns, nosort, show_path, graph);
+    }
+
+    if (result.count("data-sources")) {
+        auto patterns = result["data-sources"].as<std::vector<std::string>>();
+        if (!patterns.empty())
+            return cmd_data_sources(patterns, nosort, graph);
+    }
+
+    if (result.count("data-sinks")) {
+        auto patterns = result["data-sinks"].as<std::vector<std::string>>();
+        if (!patterns.empty())
+            return cmd_data_sinks(patterns, nosort, graph);
+    }
+
+    if (result.count("vars")) {
+        auto patterns = result["vars"].as<std::vector<std::string>>();
+        if (!patterns.empty())
+            return cmd_list_variables(patterns, nosort, graph);
+    }
+
+    if (result.count("member")) {
+        auto patterns = result["member"].as<std::vector<std::string>>();
+        if (!patterns.empty())
+            return cmd_find_member(patterns, nosort, graph);
+    }
+
+    if (result.count("reachable")) {
+        auto symbols = result["reachable"].as<std::vector<std::string>>();
+        if (!symbols.empty())
+            return cmd_reachable(symbols, graph);
+    }
+
+    std::vector<std::string> start_chain, end_chain;
+    if (result.count("start"))
+        start_chain = result["start"].as<std::vector<std::string>>();
+    if (result.count("end"))
+        end_chain = result["end"].as<std::vector<std::string>>();
+    bool backtrace = result.count("backtrace") > 0;
+    bool pattern_match = result.count("pattern") > 0;
+    size_t shortest_k = result["shortest"].as<size_t>();
+    uint32_t exclude_hubs = result["exclude-hubs"].as<uint32_t>();
+
+    if (!start_chain.empty() || !end_chain.empty() || backtrace)
+        return cmd_query(start_chain, end_chain, backtrace, pattern_match, nosort, show_path,
+                         shortest_k, exclude_hubs, scope, graph);
+
+    std::cerr << "Error: daemon cannot serve this command" << std::endl;
+    return 1;
+}
+
+} // namespace
+
+int cmd_daemon(bool watch) {
+    Graph graph;
+    if (!load_graph(graph))
+        return 1;
+
+    IndexerConfig watch_config;
+    watch_config.root_path = ".";
+
+    // Kept for the daemon's lifetime so successive re-indexes of the same
+    // file go through the incremental reparse path
+    ParserCache parser_cache;
+    if (watch) {
+        watch_config.parser_cache = &parser_cache;
+    }
+
+    TreeWatcher watcher;
+    if (watch && !watcher.init(watch_config)) {
+        std::cerr << "Error: failed to initialize inotify: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    int listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        std::cerr << "Error: failed to create socket: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, DAEMON_SOCKET_FILE, sizeof(addr.sun_path) - 1);
+
+    // A previous daemon may have left a stale socket file behind.
+    ::unlink(DAEMON_SOCKET_FILE);
+
+    if (::bind(listen_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+        std::cerr << "Error: failed to bind " << DAEMON_SOCKET_FILE << ": "
+                  << std::strerror(errno) << std::endl;
+        ::close(listen_fd);
+        return 1;
+    }
+
+    if (::listen(listen_fd, 8) < 0) {
+        std::cerr << "Error: failed to listen on " << DAEMON_SOCKET_FILE << ": "
+                  << std::strerror(errno) << std::endl;
+        ::close(listen_fd);
+        ::unlink(DAEMON_SOCKET_FILE);
+        return 1;
+    }
+
+    std::signal(SIGINT, handle_signal);
+    std::signal(SIGTERM, handle_signal);
+
+    std::cout << "Daemon ready - serving " << graph.get_symbol_map().size() << " symbols on "
+              << DAEMON_SOCKET_FILE << std::endl;
+    if (watch)
+        std::cout << "Watching for source changes (re-index after " << WATCH_DEBOUNCE_MS
+                  << " ms of quiet)." << std::endl;
+
+    bool reindex_pending = false;
+    while (!g_stop_requested) {
+        pollfd fds[2];
+        fds[0] = {listen_fd, POLLIN, 0};
+        nfds_t nfds = 1;
+        if (watch) {
+            fds[1] = {watcher.fd(), POLLIN, 0};
+            nfds = 2;
+        }
+
+        // While a re-index is pending, poll with the debounce as timeout;
+        // timing out means the edit burst went quiet and it is time to
+        // re-parse. Otherwise block until a client or an event arrives.
+        int ready = ::poll(fds, nfds, reindex_pending ? WATCH_DEBOUNCE_MS : -1);
+        if (ready < 0) {
+            if (errno == EINTR)
+                continue;
+            std::cerr << "Error: poll failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        if (ready == 0) {
+            reindex_resident(graph, watch_config);
+            reindex_pending = false;
+            std::cout << "Index republished - serving " << graph.get_symbol_map().size()
+                      << " symbols." << std::endl;
+            continue;
+        }
+
+        if (watch && (fds[1].revents & POLLIN) && watcher.drain())
+            reindex_pending = true;
+
+        if (!(fds[0].revents & POLLIN))
+            continue;
+
+        int client = ::accept(listen_fd, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR)
+                continue;
+            std::cerr << "Error: accept failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+
+        std::vector<std::string> args;
+        if (!read_request(client, args) || args.empty()) {
+            ::close(client); // liveness probe or broken client
+            continue;
+        }
+
+        if (args.size() == 1 && args[0] == "--daemon-stop") {
+            write_all(client, "0\n", 2);
+            ::close(client);
+            break;
+        }
+
+        // Run the command with std::cout/std::cerr captured so the client
+        // sees exactly what a local invocation would have printed.
+        std::ostringstream captured;
+        std::streambuf *old_out = std::cout.rdbuf(captured.rdbuf());
+        std::streambuf *old_err = std::cerr.rdbuf(captured.rdbuf());
+        int code = 1;
+        try {
+            code = run_command(args, graph);
+        } catch (const std::exception &e) {
+            captured << "Error: " << e.what() << std::endl;
+        }
+        std::cout.rdbuf(old_out);
+        std::cerr.rdbuf(old_err);
+
+        std::string response = std::to_string(code) + "\n" + captured.str();
+        write_all(client, response.data(), response.size());
+        ::close(client);
+    }
+
+    ::close(listen_fd);
+    ::unlink(DAEMON_SOCKET_FILE);
+    std::cout << "Daemon stopped." << std::endl;
+    return 0;
+}
+
+int cmd_daemon_stop() {
+    int code = forward_to_daemon({"--daemon-stop"});
+    if (code < 0) {
+        std::cerr << "Error: no daemon running on " << DAEMON_SOCKET_FILE << std::endl;
+        return 1;
+    }
+    std::cout << "Daemon stopped." << std::endl;
+    return 0;
+}
+
+bool daemon_running() {
+    int fd = connect_to_daemon();
+    if (fd < 0)
+        return false;
+    ::close(fd);
+    return true;
+}
+
+int forward_to_daemon(const std::vector<std::string> &args) {
+    int fd = connect_to_daemon();
+    if (fd < 0)
+        return -1;
+
+    std::string request;
+    for (const auto &arg : args) {
+        request += arg;
+        request += '\n';
+    }
+    request += '\n';
+
+    if (!write_all(fd, request.data(), request.size())) {
+        ::close(fd);
+        return -1;
+    }
+    ::shutdown(fd, SHUT_WR);
+
+    std::string response;
+    char chunk[4096];
+    for (;;) {
+        ssize_t n = ::read(fd, chunk, sizeof(chunk));
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            ::close(fd);
+            return -1;
+        }
+        if (n == 0)
+            break;
+        response.append(chunk, static_cast<size_t>(n));
+    }
+    ::close(fd);
+
+    size_t nl = response.find('\n');
+    if (nl == std::string::npos)
+        return -1;
+
+    int code;
+    try {
+        code = std::stoi(response.substr(0, nl));
+    } catch (...) {
+        return -1;
+    }
+
+    std::cout << response.substr(nl + 1);
+    std::cout.flush();
+    return code;
+}
+
+} // namespace pioneer
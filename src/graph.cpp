@@ -13,10 +13,18 @@
 // limitations under the License.
 
 #include "pioneer/graph.hpp"
+#include "pioneer/profile.hpp"
 #include "pioneer/version.hpp"
+#include "pioneer/zstd_stream.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
+#include <functional>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 
 namespace pioneer {
 
@@ -42,8 +50,8 @@ static json path_node_to_json(const PathNode &node) {
 }
 
 SymbolUID Graph::add_symbol(const std::string &qualified_name, SymbolType type) {
-    SymbolUID uid = call_graph.get_or_create_uid(qualified_name);
-    call_graph.symbol_types[uid] = type;
+    SymbolUID uid = call_graph.get_or_create_uid(qualified_name, type);
+    call_graph.set_symbol_type(uid, type);
     return uid;
 }
 
@@ -101,6 +109,122 @@ void Graph::add_data_flow(const std::string &source, const std::string &dest) {
 
 void Graph::finalize() { call_graph.finalize(); }
 
+void Graph::merge(const Graph &other) {
+    const CallGraph &src = other.call_graph;
+    CallGraph &cg = call_graph;
+
+    // Remap source UIDs by symbol name; symbols first so the edge loops
+    // below can go through the remap table only
+    std::unordered_map<SymbolUID, SymbolUID> remap;
+    remap.reserve(src.symbol_to_uid.size());
+
+    for (const auto &[name, src_uid] : src.symbol_to_uid) {
+        SymbolUID uid = cg.get_or_create_uid(name, src.get_type(src_uid));
+        remap[src_uid] = uid;
+
+        auto file_it = src.symbol_to_file.find(src_uid);
+        if (file_it != src.symbol_to_file.end() &&
+            cg.symbol_to_file.find(uid) == cg.symbol_to_file.end()) {
+            std::string path = other.get_file_path(file_it->second);
+            if (!path.empty()) {
+                SymbolUID file_uid = get_or_create_file_uid(path);
+                cg.symbol_to_file[uid] = file_uid;
+                cg.file_to_symbols[file_uid].push_back(uid);
+            }
+        }
+    }
+
+    for (const auto &[caller, callees] : src.call_map) {
+        SymbolUID mapped_caller = remap[caller];
+        for (SymbolUID callee : callees) {
+            cg.add_call(mapped_caller, remap[callee]);
+        }
+    }
+
+    for (const auto &[source, dests] : src.data_flow_map) {
+        SymbolUID mapped_source = remap[source];
+        for (SymbolUID dest : dests) {
+            cg.add_data_flow(mapped_source, remap[dest]);
+        }
+    }
+
+    // Freshness metadata rides along so incremental re-indexing still
+    // recognizes unchanged files on a merged graph
+    for (const auto &[file_uid, meta] : src.file_meta) {
+        std::string path = other.get_file_path(file_uid);
+        if (!path.empty()) {
+            cg.file_meta[get_or_create_file_uid(path)] = meta;
+        }
+    }
+
+    // Shards carry their own END sentinel; the name-based remap has already
+    // collapsed it onto ours, or introduced it if this graph had none
+    if (cg.end_uid == INVALID_UID) {
+        auto it = cg.symbol_to_uid.find("END");
+        if (it != cg.symbol_to_uid.end()) {
+            cg.end_uid = it->second;
+        }
+    }
+
+    // The path trie is derived from the (now extended) file table
+    cg.path_trie_built = false;
+}
+
+// Aggregate statistics persisted inside the metadata header so `--stats`
+// can answer from the first few kilobytes of the index without loading the
+// graph body. The degree histogram uses power-of-two buckets: bucket 0
+// holds isolated symbols, bucket k holds total call degrees in
+// [2^(k-1), 2^k).
+static json stats_to_json(const CallGraph &cg) {
+    json stats;
+
+    size_t call_edges = 0;
+    for (const auto &[uid, callees] : cg.call_map) {
+        call_edges += callees.size();
+    }
+    size_t data_flow_edges = 0;
+    for (const auto &[uid, dests] : cg.data_flow_map) {
+        data_flow_edges += dests.size();
+    }
+    stats["num_call_edges"] = call_edges;
+    stats["num_data_flow_edges"] = data_flow_edges;
+
+    json by_language = json::object();
+    for (const auto &[file_uid, path_idx] : cg.file_uid_to_path_idx) {
+        const std::string &path = cg.filepath_pool.get(path_idx);
+        size_t dot = path.find_last_of('.');
+        Language lang = (dot == std::string::npos) ? Language::Unknown
+                                                   : language_from_extension(path.substr(dot));
+        const char *name = language_to_string(lang);
+        by_language[name] = by_language.value(name, 0) + 1;
+    }
+    stats["files_by_language"] = std::move(by_language);
+
+    std::vector<uint64_t> histogram(17, 0);
+    for (const auto &[name, uid] : cg.symbol_to_uid) {
+        if (uid == cg.end_uid) {
+            continue;
+        }
+        size_t degree = 0;
+        auto out_it = cg.call_map.find(uid);
+        if (out_it != cg.call_map.end()) {
+            degree += out_it->second.size();
+        }
+        auto in_it = cg.reverse_call_map.find(uid);
+        if (in_it != cg.reverse_call_map.end()) {
+            degree += in_it->second.size();
+        }
+        size_t bucket = 0;
+        while (bucket < histogram.size() - 1 && (size_t{1} << bucket) <= degree) {
+            bucket++;
+        }
+        histogram[bucket]++;
+    }
+    stats["degree_histogram"] = std::move(histogram);
+
+    return stats;
+}
+
 static void write_json_string(std::ostringstream &out, const std::string &s) {
     out << '"';
     for (char c : s) {
@@ -141,154 +265,239 @@ static void write_json_string(std::ostringstream &out, const std::string &s) {
 }
 
 void Graph::save(const std::string &filepath) const {
+    prof::ScopedTimer timer("save.total");
+
     std::ofstream file(filepath, std::ios::out | std::ios::binary);
     if (!file.is_open()) {
         throw std::runtime_error("Failed to open file for writing: " + filepath);
     }
 
-    // Use a large string buffer to minimize system calls
-    std::ostringstream buffer;
-    buffer.str().reserve(64 * 1024 * 1024); // Pre-allocate 64MB
-
-    // Lambda to flush buffer periodically
-    auto flush_if_large = [&]() {
-        if (buffer.tellp() > 32 * 1024 * 1024) { // Flush every 32MB
-            file << buffer.str();
-            buffer.str("");
-            buffer.clear();
+    // Compress transparently: the symbol text is highly repetitive, and
+    // load() plus the streaming readers detect the zstd magic, so older
+    // uncompressed indexes keep loading
+    ZstdOstream zout(file);
+
+    // The top-level sections are independent, so each encodes into its own
+    // buffer on a worker pool while the writer below streams completed
+    // buffers out in document order - encoding of later sections overlaps
+    // compression and disk writes of earlier ones. Concatenating the
+    // buffers yields exactly the document the old single-pass writer
+    // produced (compact format, no whitespace).
+    using SectionEncoder = std::function<std::string()>;
+    std::vector<SectionEncoder> encoders;
+
+    // Metadata + UIDs mapping - uses custom string escaping
+    encoders.push_back([this] {
+        std::ostringstream out;
+        out << "{\"metadata\":{";
+        out << "\"version\":\"" << INDEX_SCHEMA_VERSION << "\",";
+        out << "\"num_symbols\":" << call_graph.num_symbols() << ",";
+        out << "\"num_functions\":" << call_graph.num_functions() << ",";
+        out << "\"num_variables\":" << call_graph.num_variables() << ",";
+        out << "\"end_uid\":" << call_graph.end_uid << ",";
+        out << "\"num_files\":" << call_graph.file_uid_to_path_idx.size() << ",";
+        out << "\"stats\":" << stats_to_json(call_graph).dump() << ",";
+        out << "\"UIDs\":{";
+        bool first = true;
+        for (const auto &[name, uid] : call_graph.symbol_to_uid) {
+            if (!first)
+                out << ",";
+            first = false;
+            write_json_string(out, name);
+            out << ":" << uid;
         }
-    };
-
-    // Write JSON incrementally - compact format (no whitespace)
-    buffer << "{\"metadata\":{";
-    buffer << "\"version\":\"" << INDEX_SCHEMA_VERSION << "\",";
-    buffer << "\"num_symbols\":" << call_graph.num_symbols() << ",";
-    buffer << "\"num_functions\":" << call_graph.num_functions() << ",";
-    buffer << "\"num_variables\":" << call_graph.num_variables() << ",";
-    buffer << "\"end_uid\":" << call_graph.end_uid << ",";
-    buffer << "\"num_files\":" << call_graph.file_uid_to_path_idx.size() << ",";
-
-    // UIDs mapping - use custom string escaping
-    buffer << "\"UIDs\":{";
-    bool first = true;
-    for (const auto &[name, uid] : call_graph.symbol_to_uid) {
-        if (!first)
-            buffer << ",";
-        first = false;
-        write_json_string(buffer, name);
-        buffer << ":" << uid;
-    }
-    buffer << "}},";
-    flush_if_large();
+        out << "}},";
+        return std::move(out).str();
+    });
 
     // Symbol types
-    buffer << "\"symbol_types\":{";
-    first = true;
-    for (const auto &[uid, type] : call_graph.symbol_types) {
-        if (!first)
-            buffer << ",";
-        first = false;
-        buffer << "\"" << uid << "\":" << static_cast<int>(type);
-    }
-    buffer << "},";
-    flush_if_large();
+    encoders.push_back([this] {
+        std::ostringstream out;
+        out << "\"symbol_types\":{";
+        bool first = true;
+        for (const auto &[uid, type] : call_graph.symbol_types) {
+            if (!first)
+                out << ",";
+            first = false;
+            out << "\"" << uid << "\":" << static_cast<int>(type);
+        }
+        out << "},";
+        return std::move(out).str();
+    });
 
     // Call mapping
-    buffer << "\"call_mapping\":{";
-    first = true;
-    for (const auto &[caller_uid, callees] : call_graph.call_map) {
-        if (!first)
-            buffer << ",";
-        first = false;
-        buffer << "\"" << caller_uid << "\":[";
-        bool first_callee = true;
-        for (SymbolUID callee : callees) {
-            if (!first_callee)
-                buffer << ",";
-            first_callee = false;
-            buffer << callee;
+    encoders.push_back([this] {
+        std::ostringstream out;
+        out << "\"call_mapping\":{";
+        bool first = true;
+        for (const auto &[caller_uid, callees] : call_graph.call_map) {
+            if (!first)
+                out << ",";
+            first = false;
+            out << "\"" << caller_uid << "\":[";
+            bool first_callee = true;
+            for (SymbolUID callee : callees) {
+                if (!first_callee)
+                    out << ",";
+                first_callee = false;
+                out << callee;
+            }
+            out << "]";
         }
-        buffer << "]";
-    }
-    buffer << "},";
-    flush_if_large();
+        out << "},";
+        return std::move(out).str();
+    });
 
     // Data flow mapping
-    buffer << "\"data_flow\":{";
-    first = true;
-    for (const auto &[source_uid, dests] : call_graph.data_flow_map) {
-        if (!first)
-            buffer << ",";
-        first = false;
-        buffer << "\"" << source_uid << "\":[";
-        bool first_dest = true;
-        for (SymbolUID dest : dests) {
-            if (!first_dest)
-                buffer << ",";
-            first_dest = false;
-            buffer << dest;
+    encoders.push_back([this] {
+        std::ostringstream out;
+        out << "\"data_flow\":{";
+        bool first = true;
+        for (const auto &[source_uid, dests] : call_graph.data_flow_map) {
+            if (!first)
+                out << ",";
+            first = false;
+            out << "\"" << source_uid << "\":[";
+            bool first_dest = true;
+            for (SymbolUID dest : dests) {
+                if (!first_dest)
+                    out << ",";
+                first_dest = false;
+                out << dest;
+            }
+            out << "]";
         }
-        buffer << "]";
-    }
-    buffer << "},";
-    flush_if_large();
-
-    // File paths - use custom string escaping
-    buffer << "\"file_paths\":{";
-    first = true;
-    for (const auto &[file_uid, path_idx] : call_graph.file_uid_to_path_idx) {
-        if (!first)
-            buffer << ",";
-        first = false;
-        buffer << "\"" << file_uid << "\":";
-        write_json_string(buffer, call_graph.filepath_pool.get(path_idx));
-    }
-    buffer << "},";
-    flush_if_large();
+        out << "},";
+        return std::move(out).str();
+    });
+
+    // File paths - uses custom string escaping
+    encoders.push_back([this] {
+        std::ostringstream out;
+        out << "\"file_paths\":{";
+        bool first = true;
+        for (const auto &[file_uid, path_idx] : call_graph.file_uid_to_path_idx) {
+            if (!first)
+                out << ",";
+            first = false;
+            out << "\"" << file_uid << "\":";
+            write_json_string(out, call_graph.filepath_pool.get(path_idx));
+        }
+        out << "},";
+        return std::move(out).str();
+    });
 
     // File to symbols mapping
-    buffer << "\"file_symbols\":{";
-    first = true;
-    for (const auto &[file_uid, symbol_uids] : call_graph.file_to_symbols) {
-        if (!first)
-            buffer << ",";
-        first = false;
-        buffer << "\"" << file_uid << "\":[";
-        bool first_sym = true;
-        for (SymbolUID sym : symbol_uids) {
-            if (!first_sym)
-                buffer << ",";
-            first_sym = false;
-            buffer << sym;
-        }
-        buffer << "]";
-    }
-    buffer << "},";
-    flush_if_large();
+    encoders.push_back([this] {
+        std::ostringstream out;
+        out << "\"file_symbols\":{";
+        bool first = true;
+        for (const auto &[file_uid, symbol_uids] : call_graph.file_to_symbols) {
+            if (!first)
+                out << ",";
+            first = false;
+            out << "\"" << file_uid << "\":[";
+            bool first_sym = true;
+            for (SymbolUID sym : symbol_uids) {
+                if (!first_sym)
+                    out << ",";
+                first_sym = false;
+                out << sym;
+            }
+            out << "]";
+        }
+        out << "},";
+        return std::move(out).str();
+    });
 
     // Symbol to file mapping
-    buffer << "\"symbol_files\":{";
-    first = true;
-    for (const auto &[symbol_uid, file_uid] : call_graph.symbol_to_file) {
-        if (!first)
-            buffer << ",";
-        first = false;
-        buffer << "\"" << symbol_uid << "\":" << file_uid;
+    encoders.push_back([this] {
+        std::ostringstream out;
+        out << "\"symbol_files\":{";
+        bool first = true;
+        for (const auto &[symbol_uid, file_uid] : call_graph.symbol_to_file) {
+            if (!first)
+                out << ",";
+            first = false;
+            out << "\"" << symbol_uid << "\":" << file_uid;
+        }
+        out << "},";
+        return std::move(out).str();
+    });
+
+    // File metadata (mtime + content hash) for incremental re-indexing
+    encoders.push_back([this] {
+        std::ostringstream out;
+        out << "\"file_meta\":{";
+        bool first = true;
+        for (const auto &[file_uid, meta] : call_graph.file_meta) {
+            if (!first)
+                out << ",";
+            first = false;
+            out << "\"" << file_uid << "\":[" << meta.mtime << "," << meta.hash << "]";
+        }
+        out << "},";
+        return std::move(out).str();
+    });
+
+    // Path trie - built and serialized directly
+    encoders.push_back([this] {
+        std::unordered_map<SymbolUID, std::string> file_uid_to_path;
+        file_uid_to_path.reserve(call_graph.file_uid_to_path_idx.size());
+        for (const auto &[file_uid, path_idx] : call_graph.file_uid_to_path_idx) {
+            file_uid_to_path[file_uid] = call_graph.filepath_pool.get(path_idx);
+        }
+        PathNode path_trie = build_path_trie(file_uid_to_path);
+        std::ostringstream out;
+        out << "\"path_trie\":" << path_node_to_json(path_trie).dump() << "}";
+        return std::move(out).str();
+    });
+
+    const size_t section_count = encoders.size();
+    std::vector<std::string> sections(section_count);
+    std::vector<char> section_done(section_count, 0);
+    std::mutex done_mutex;
+    std::condition_variable section_ready;
+    std::atomic<size_t> next_section{0};
+
+    unsigned int worker_count = std::clamp(std::thread::hardware_concurrency(), 1u,
+                                           static_cast<unsigned int>(section_count));
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count);
+    for (unsigned int t = 0; t < worker_count; ++t) {
+        workers.emplace_back([&] {
+            for (;;) {
+                size_t i = next_section.fetch_add(1);
+                if (i >= section_count)
+                    break;
+                std::string encoded = encoders[i]();
+                {
+                    std::lock_guard<std::mutex> lock(done_mutex);
+                    sections[i] = std::move(encoded);
+                    section_done[i] = 1;
+                }
+                section_ready.notify_all();
+            }
+        });
     }
-    buffer << "},";
-    flush_if_large();
 
-    // Path trie - build and serialize directly
-    std::unordered_map<SymbolUID, std::string> file_uid_to_path;
-    file_uid_to_path.reserve(call_graph.file_uid_to_path_idx.size());
-    for (const auto &[file_uid, path_idx] : call_graph.file_uid_to_path_idx) {
-        file_uid_to_path[file_uid] = call_graph.filepath_pool.get(path_idx);
+    // Stream each section as soon as it is ready, freeing its buffer before
+    // waiting on the next so peak memory stays near one section, not the
+    // whole document.
+    for (size_t i = 0; i < section_count; ++i) {
+        std::string encoded;
+        {
+            std::unique_lock<std::mutex> lock(done_mutex);
+            section_ready.wait(lock, [&] { return section_done[i] != 0; });
+            encoded = std::move(sections[i]);
+        }
+        zout << encoded;
     }
-    PathNode path_trie = build_path_trie(file_uid_to_path);
-    buffer << "\"path_trie\":" << path_node_to_json(path_trie).dump() << "}";
 
-    // Final flush
-    file << buffer.str();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    zout.finish();
 }
 
 json Graph::to_json() const {
@@ -301,6 +510,7 @@ json Graph::to_json() const {
     j["metadata"]["num_variables"] = call_graph.num_variables();
     j["metadata"]["end_uid"] = call_graph.end_uid;
     j["metadata"]["num_files"] = call_graph.file_uid_to_path_idx.size();
+    j["metadata"]["stats"] = stats_to_json(call_graph);
 
     // UIDs mapping
     json uids = json::object();
@@ -357,6 +567,13 @@ json Graph::to_json() const {
     }
     j["symbol_files"] = std::move(symbol_files);
 
+    // File metadata for incremental re-indexing
+    json file_meta = json::object();
+    for (const auto &[file_uid, meta] : call_graph.file_meta) {
+        file_meta[std::to_string(file_uid)] = json::array({meta.mtime, meta.hash});
+    }
+    j["file_meta"] = std::move(file_meta);
+
     // Path trie
     std::unordered_map<SymbolUID, std::string> file_uid_to_path;
     file_uid_to_path.reserve(call_graph.file_uid_to_path_idx.size());
@@ -409,7 +626,7 @@ Graph Graph::from_json(const json &j) {
         const auto &types = j["symbol_types"];
         for (auto it = types.begin(); it != types.end(); ++it) {
             SymbolUID uid = std::stoull(it.key());
-            g.call_graph.symbol_types[uid] = static_cast<SymbolType>(it.value().get<int>());
+            g.call_graph.set_symbol_type(uid, static_cast<SymbolType>(it.value().get<int>()));
         }
     }
 
@@ -467,8 +684,21 @@ Graph Graph::from_json(const json &j) {
         }
     }
 
+    // Load file metadata (v2.3.0)
+    if (j.contains("file_meta")) {
+        const auto &file_meta = j["file_meta"];
+        for (auto it = file_meta.begin(); it != file_meta.end(); ++it) {
+            SymbolUID file_uid = std::stoull(it.key());
+            FileMeta meta;
+            meta.mtime = it.value()[0].get<int64_t>();
+            meta.hash = it.value()[1].get<uint64_t>();
+            g.call_graph.file_meta[file_uid] = meta;
+        }
+    }
+
     // Shrink string pools after loading
     g.call_graph.shrink_to_fit();
+    g.call_graph.build_csr();
 
     // Note: path_trie is not loaded as it can be rebuilt from file_uid_to_path if needed
 
@@ -480,7 +710,7 @@ class GraphSaxHandler : public json::json_sax_t {
 public:
 
     Graph &graph;
-    LoadMode mode;
+    uint32_t sections;
 
     // Parser state machine
     enum class Section {
@@ -493,6 +723,7 @@ public:
         FilePaths,
         FileSymbols,
         SymbolFiles,
+        FileMeta,
         PathTrie
     };
     Section current_section = Section::None;
@@ -506,22 +737,27 @@ public:
     bool in_array = false;
     int skip_depth = 0;
 
-    explicit GraphSaxHandler(Graph &g, LoadMode m = LoadMode::Full) : graph(g), mode(m) {}
+    explicit GraphSaxHandler(Graph &g, uint32_t s = SECTIONS_ALL) : graph(g), sections(s) {}
 
-    // Check if we should skip a section based on load mode
+    // Check if we should skip a section based on the requested mask
     bool should_skip_section(Section s) const {
-        switch (mode) {
-        case LoadMode::SymbolsOnly:
-            // Only load UIDs, SymbolTypes, Metadata
-            return s == Section::CallMapping || s == Section::DataFlow || s == Section::FilePaths ||
-                   s == Section::FileSymbols || s == Section::SymbolFiles || s == Section::PathTrie;
-        case LoadMode::WithPaths:
-            // Load symbols + file paths (for search --show-path)
-            return s == Section::CallMapping || s == Section::DataFlow || s == Section::PathTrie;
-        case LoadMode::Full:
+        switch (s) {
+        case Section::CallMapping:
+            // One JSON section feeds both directions; skipped only when
+            // neither is wanted (the unwanted direction is dropped below)
+            return (sections & (SectionCalls | SectionReverseCalls)) == 0;
+        case Section::DataFlow:
+            return (sections & (SectionDataFlow | SectionReverseDataFlow)) == 0;
+        case Section::FilePaths:
+        case Section::FileSymbols:
+        case Section::SymbolFiles:
+            return (sections & SectionFilePaths) == 0;
+        case Section::FileMeta:
+            return (sections & SectionFileMeta) == 0;
+        case Section::PathTrie:
+            return true; // Rebuilt from file paths when needed
         default:
-            // Only skip path_trie
-            return s == Section::PathTrie;
+            return false;
         }
     }
 
@@ -562,7 +798,7 @@ public:
             break;
         case Section::SymbolTypes: {
             SymbolUID uid = std::stoull(current_key);
-            graph.call_graph.symbol_types[uid] = static_cast<SymbolType>(val);
+            graph.call_graph.set_symbol_type(uid, static_cast<SymbolType>(val));
         } break;
         case Section::SymbolFiles: {
             SymbolUID symbol_uid = std::stoull(current_key);
@@ -655,21 +891,38 @@ public:
         case Section::CallMapping: {
             SymbolUID caller = std::stoull(current_key);
             for (SymbolUID callee : current_array) {
-                graph.call_graph.call_map[caller].insert(callee);
-                graph.call_graph.reverse_call_map[callee].insert(caller);
+                if (sections & SectionCalls) {
+                    graph.call_graph.call_map[caller].insert(callee);
+                }
+                if (sections & SectionReverseCalls) {
+                    graph.call_graph.reverse_call_map[callee].insert(caller);
+                }
             }
         } break;
         case Section::DataFlow: {
             SymbolUID source = std::stoull(current_key);
             for (SymbolUID dest : current_array) {
-                graph.call_graph.data_flow_map[source].insert(dest);
-                graph.call_graph.reverse_data_flow_map[dest].insert(source);
+                if (sections & SectionDataFlow) {
+                    graph.call_graph.data_flow_map[source].insert(dest);
+                }
+                if (sections & SectionReverseDataFlow) {
+                    graph.call_graph.reverse_data_flow_map[dest].insert(source);
+                }
             }
         } break;
         case Section::FileSymbols: {
             SymbolUID file_uid = std::stoull(current_key);
             graph.call_graph.file_to_symbols[file_uid] = std::move(current_array);
         } break;
+        case Section::FileMeta: {
+            if (current_array.size() == 2) {
+                SymbolUID file_uid = std::stoull(current_key);
+                FileMeta meta;
+                meta.mtime = static_cast<int64_t>(current_array[0]);
+                meta.hash = current_array[1];
+                graph.call_graph.file_meta[file_uid] = meta;
+            }
+        } break;
         default:
             break;
         }
@@ -699,6 +952,8 @@ public:
                 current_section = Section::FileSymbols;
             else if (key == "symbol_files")
                 current_section = Section::SymbolFiles;
+            else if (key == "file_meta")
+                current_section = Section::FileMeta;
             else if (key == "path_trie")
                 current_section = Section::PathTrie;
         } else if (depth == 2 && current_section == Section::Metadata && key == "UIDs") {
@@ -719,21 +974,44 @@ public:
 Graph Graph::load(const std::string &filepath) { return load(filepath, LoadMode::Full); }
 
 Graph Graph::load(const std::string &filepath, LoadMode mode) {
-    std::ifstream file(filepath);
+    return load(filepath, sections_for(mode));
+}
+
+Graph Graph::load(const std::string &filepath, uint32_t sections) {
+    prof::ScopedTimer load_timer("load.total");
+
+    std::ifstream file(filepath, std::ios::in | std::ios::binary);
     if (!file.is_open()) {
         throw std::runtime_error("Failed to open file for reading: " + filepath);
     }
 
     Graph g;
-    GraphSaxHandler handler(g, mode);
-
-    // Use SAX parser - processes JSON without building DOM
-    bool result = json::sax_parse(file, &handler);
+    GraphSaxHandler handler(g, sections);
+
+    // Use SAX parser - processes JSON without building DOM; compressed
+    // indexes decode frame by frame through the same streaming path
+    bool result;
+    {
+        prof::ScopedTimer timer("load.sax_parse");
+        if (stream_is_zstd(file)) {
+            ZstdIstream zin(file);
+            result = json::sax_parse(zin, &handler);
+        } else {
+            result = json::sax_parse(file, &handler);
+        }
+    }
     if (!result) {
         throw std::runtime_error("Failed to parse index file: " + filepath);
     }
 
     g.call_graph.shrink_to_fit();
+
+    // Pack whatever adjacency was requested; loads that carry none skip the
+    // pass entirely.
+    if (sections & SECTIONS_ADJACENCY) {
+        prof::ScopedTimer timer("load.build_csr");
+        g.call_graph.build_csr();
+    }
     return g;
 }
 
@@ -753,6 +1031,24 @@ const std::unordered_set<SymbolUID> &Graph::get_callers(SymbolUID callee) const
     return (it != call_graph.reverse_call_map.end()) ? it->second : empty;
 }
 
+NeighborRange Graph::csr_callees(SymbolUID caller) const {
+    return call_graph.csr_call.neighbors(caller);
+}
+
+NeighborRange Graph::csr_callers(SymbolUID callee) const {
+    return call_graph.csr_reverse_call.neighbors(callee);
+}
+
+NeighborRange Graph::csr_data_sinks(SymbolUID source) const {
+    return call_graph.csr_data_flow.neighbors(source);
+}
+
+NeighborRange Graph::csr_data_sources(SymbolUID variable) const {
+    return call_graph.csr_reverse_data_flow.neighbors(variable);
+}
+
+uint32_t Graph::symbol_degree(SymbolUID uid) const { return call_graph.symbol_degree(uid); }
+
 const std::unordered_set<SymbolUID> &Graph::get_data_sources(SymbolUID variable) const {
     static const std::unordered_set<SymbolUID> empty;
     auto it = call_graph.reverse_data_flow_map.find(variable);
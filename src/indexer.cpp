@@ -13,7 +13,11 @@
 // limitations under the License.
 
 #include "pioneer/indexer.hpp"
+#include "pioneer/profile.hpp"
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <string_view>
 #include <unordered_map>
@@ -57,38 +61,276 @@ std::vector<fs::path> Indexer::discover_files() {
         return files;
     }
 
+    // Each directory is one unit of work. Workers pop a directory, list it,
+    // and push its subdirectories back; in_flight tracks listings still in
+    // progress, because they may produce more work after the stack drains.
+    std::mutex mutex;
+    std::condition_variable work_available;
     std::vector<fs::path> dirs_to_visit;
     dirs_to_visit.push_back(root);
+    size_t in_flight = 0;
 
-    while (!dirs_to_visit.empty()) {
-        fs::path current_dir = dirs_to_visit.back();
-        dirs_to_visit.pop_back();
+    // Directory listing is latency-bound (worst on network filesystems),
+    // not CPU-bound, so a handful of walkers is enough.
+    unsigned int walker_count = std::clamp(config_.num_threads, 1u, 8u);
+    std::vector<std::vector<fs::path>> found(walker_count);
 
-        std::error_code ec;
-        for (const auto &entry : fs::directory_iterator(current_dir, ec)) {
-            if (ec)
-                continue;
+    auto walk = [&](std::vector<fs::path> &local_files) {
+        for (;;) {
+            fs::path current_dir;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                work_available.wait(lock,
+                                    [&] { return !dirs_to_visit.empty() || in_flight == 0; });
+                if (dirs_to_visit.empty())
+                    return;
+                current_dir = std::move(dirs_to_visit.back());
+                dirs_to_visit.pop_back();
+                ++in_flight;
+            }
 
-            const fs::path &path = entry.path();
-            if (should_ignore(path))
-                continue;
+            std::vector<fs::path> subdirs;
+            std::error_code ec;
+            for (const auto &entry : fs::directory_iterator(current_dir, ec)) {
+                if (ec)
+                    continue;
+
+                const fs::path &path = entry.path();
+                if (should_ignore(path))
+                    continue;
+
+                if (entry.is_directory()) {
+                    subdirs.push_back(path);
+                } else if (entry.is_regular_file()) {
+                    std::string ext = path.extension().string();
+                    Language lang = language_from_extension(ext);
+                    if (lang != Language::Unknown) {
+                        local_files.push_back(path);
+                    }
+                }
+            }
 
-            if (entry.is_directory()) {
-                dirs_to_visit.push_back(path);
-            } else if (entry.is_regular_file()) {
-                std::string ext = path.extension().string();
-                Language lang = language_from_extension(ext);
-                if (lang != Language::Unknown) {
-                    files.push_back(path);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                --in_flight;
+                for (auto &dir : subdirs) {
+                    dirs_to_visit.push_back(std::move(dir));
+                }
+                // Wake idle walkers for the new work, or everyone when the
+                // walk has fully drained
+                if (!dirs_to_visit.empty() || in_flight == 0) {
+                    work_available.notify_all();
                 }
             }
         }
+    };
+
+    std::vector<std::thread> walkers;
+    for (unsigned int t = 0; t < walker_count; ++t) {
+        walkers.emplace_back(walk, std::ref(found[t]));
+    }
+    for (auto &t : walkers) {
+        t.join();
     }
 
+    for (auto &local : found) {
+        for (auto &f : local) {
+            files.push_back(std::move(f));
+        }
+    }
+
+    // Sorted order keeps batching and output deterministic no matter which
+    // walker discovered which directory
     std::sort(files.begin(), files.end());
     return files;
 }
 
+// On-disk parse cache: one compact entry per (content hash, file path),
+// shared by every checkout that indexes the same tree. The path is part of
+// the key because extraction depends on it (C statics are qualified by
+// filename); the stored hash and path are verified on load so a key
+// collision degrades to a re-parse, never to wrong results.
+constexpr const char *PARSE_CACHE_DIR = ".pioneer-cache";
+constexpr char PARSE_CACHE_MAGIC[8] = "PCACHE1"; // Bump on format changes
+
+static fs::path parse_cache_path(uint64_t content_hash, const std::string &filepath) {
+    uint64_t key =
+        content_hash ^ (fnv1a_hash(filepath.data(), filepath.size()) * 0x9e3779b97f4a7c15ULL);
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return fs::path(PARSE_CACHE_DIR) / name;
+}
+
+static void write_cache_string(std::ofstream &out, const std::string &str) {
+    uint32_t length = static_cast<uint32_t>(str.size());
+    out.write(reinterpret_cast<const char *>(&length), sizeof(length));
+    out.write(str.data(), length);
+}
+
+static bool read_cache_string(std::ifstream &in, std::string &str) {
+    uint32_t length = 0;
+    if (!in.read(reinterpret_cast<char *>(&length), sizeof(length)))
+        return false;
+    if (length > (64u << 20)) // Corrupt entry; no source string is this long
+        return false;
+    str.resize(length);
+    return static_cast<bool>(in.read(str.data(), length));
+}
+
+static bool load_parse_cache(const fs::path &entry, uint64_t content_hash,
+                             const std::string &filepath, std::vector<FunctionInfo> &functions_out,
+                             std::vector<CallInfo> &calls_out,
+                             std::vector<VariableInfo> &variables_out) {
+    std::ifstream in(entry, std::ios::in | std::ios::binary);
+    if (!in.is_open())
+        return false;
+
+    size_t functions_mark = functions_out.size();
+    size_t calls_mark = calls_out.size();
+    size_t variables_mark = variables_out.size();
+
+    auto miss = [&]() {
+        functions_out.resize(functions_mark);
+        calls_out.resize(calls_mark);
+        variables_out.resize(variables_mark);
+        return false;
+    };
+
+    char magic[sizeof(PARSE_CACHE_MAGIC)] = {};
+    uint64_t stored_hash = 0;
+    std::string stored_path;
+    if (!in.read(magic, sizeof(magic)) ||
+        std::memcmp(magic, PARSE_CACHE_MAGIC, sizeof(magic)) != 0 ||
+        !in.read(reinterpret_cast<char *>(&stored_hash), sizeof(stored_hash)) ||
+        stored_hash != content_hash || !read_cache_string(in, stored_path) ||
+        stored_path != filepath) {
+        return miss();
+    }
+
+    uint32_t num_functions = 0, num_calls = 0, num_variables = 0;
+    if (!in.read(reinterpret_cast<char *>(&num_functions), sizeof(num_functions)) ||
+        !in.read(reinterpret_cast<char *>(&num_calls), sizeof(num_calls)) ||
+        !in.read(reinterpret_cast<char *>(&num_variables), sizeof(num_variables))) {
+        return miss();
+    }
+
+    for (uint32_t i = 0; i < num_functions; ++i) {
+        FunctionInfo info;
+        if (!read_cache_string(in, info.qualified_name))
+            return miss();
+        info.file_path = filepath;
+        uint32_t num_params = 0;
+        if (!in.read(reinterpret_cast<char *>(&num_params), sizeof(num_params)))
+            return miss();
+        info.param_types.resize(num_params);
+        for (uint32_t p = 0; p < num_params; ++p) {
+            if (!read_cache_string(in, info.param_types[p]))
+                return miss();
+        }
+        functions_out.push_back(std::move(info));
+    }
+
+    for (uint32_t i = 0; i < num_calls; ++i) {
+        CallInfo info;
+        if (!read_cache_string(in, info.caller_name) || !read_cache_string(in, info.callee_name))
+            return miss();
+        calls_out.push_back(std::move(info));
+    }
+
+    for (uint32_t i = 0; i < num_variables; ++i) {
+        VariableInfo info;
+        uint8_t from_call = 0;
+        if (!read_cache_string(in, info.qualified_name) ||
+            !read_cache_string(in, info.containing_func) ||
+            !read_cache_string(in, info.value_source) ||
+            !in.read(reinterpret_cast<char *>(&from_call), sizeof(from_call)))
+            return miss();
+        info.from_function_call = from_call != 0;
+        variables_out.push_back(std::move(info));
+    }
+
+    return true;
+}
+
+static void save_parse_cache(const fs::path &entry, uint64_t content_hash,
+                             const std::string &filepath,
+                             const std::vector<FunctionInfo> &functions,
+                             const std::vector<CallInfo> &calls,
+                             const std::vector<VariableInfo> &variables) {
+    std::error_code ec;
+    fs::create_directories(PARSE_CACHE_DIR, ec);
+    if (ec)
+        return;
+
+    // Write to a per-thread temp name and rename so concurrent builds never
+    // observe a half-written entry
+    fs::path tmp = entry;
+    tmp += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream out(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+            return;
+
+        out.write(PARSE_CACHE_MAGIC, sizeof(PARSE_CACHE_MAGIC));
+        out.write(reinterpret_cast<const char *>(&content_hash), sizeof(content_hash));
+        write_cache_string(out, filepath);
+
+        uint32_t num_functions = static_cast<uint32_t>(functions.size());
+        uint32_t num_calls = static_cast<uint32_t>(calls.size());
+        uint32_t num_variables = static_cast<uint32_t>(variables.size());
+        out.write(reinterpret_cast<const char *>(&num_functions), sizeof(num_functions));
+        out.write(reinterpret_cast<const char *>(&num_calls), sizeof(num_calls));
+        out.write(reinterpret_cast<const char *>(&num_variables), sizeof(num_variables));
+
+        for (const auto &info : functions) {
+            write_cache_string(out, info.qualified_name);
+            uint32_t num_params = static_cast<uint32_t>(info.param_types.size());
+            out.write(reinterpret_cast<const char *>(&num_params), sizeof(num_params));
+            for (const auto &param : info.param_types) {
+                write_cache_string(out, param);
+            }
+        }
+        for (const auto &info : calls) {
+            write_cache_string(out, info.caller_name);
+            write_cache_string(out, info.callee_name);
+        }
+        for (const auto &info : variables) {
+            write_cache_string(out, info.qualified_name);
+            write_cache_string(out, info.containing_func);
+            write_cache_string(out, info.value_source);
+            uint8_t from_call = info.from_function_call ? 1 : 0;
+            out.write(reinterpret_cast<const char *>(&from_call), sizeof(from_call));
+        }
+
+        if (!out) {
+            out.close();
+            fs::remove(tmp, ec);
+            return;
+        }
+    }
+
+    fs::rename(tmp, entry, ec);
+    if (ec)
+        fs::remove(tmp, ec);
+}
+
+// One parser per language per worker thread, reused across files. TSParser
+// construction plus query-cursor setup is measurable across tens of
+// thousands of small files; parse() already resets all per-file state.
+static LanguageParser *thread_parser(Language lang) {
+    constexpr size_t SLOTS = 4; // Language enum: Unknown, Python, C, Cpp
+    thread_local std::unique_ptr<LanguageParser> parsers[SLOTS];
+
+    size_t slot = static_cast<size_t>(lang);
+    if (slot == 0 || slot >= SLOTS) {
+        return nullptr;
+    }
+    if (!parsers[slot]) {
+        parsers[slot] = create_parser(lang);
+    }
+    return parsers[slot].get();
+}
+
 bool Indexer::parse_file(const fs::path &filepath, std::vector<FunctionInfo> &functions_out,
                          std::vector<CallInfo> &calls_out,
                          std::vector<VariableInfo> &variables_out) {
@@ -96,6 +338,13 @@ bool Indexer::parse_file(const fs::path &filepath, std::vector<FunctionInfo> &fu
     if (!mmap.open(filepath.string()))
         return false;
 
+    return parse_buffer(filepath, mmap, functions_out, calls_out, variables_out);
+}
+
+bool Indexer::parse_buffer(const fs::path &filepath, const MemoryMappedFile &mmap,
+                           std::vector<FunctionInfo> &functions_out,
+                           std::vector<CallInfo> &calls_out,
+                           std::vector<VariableInfo> &variables_out) {
     if (mmap.size() == 0)
         return true;
 
@@ -104,9 +353,38 @@ bool Indexer::parse_file(const fs::path &filepath, std::vector<FunctionInfo> &fu
     if (lang == Language::Unknown)
         return false;
 
-    auto parser = create_parser(lang);
-    if (!parser || !parser->parse(mmap.data(), mmap.size()))
-        return false;
+    uint64_t content_hash = 0;
+    fs::path cache_entry;
+    if (config_.parse_cache) {
+        content_hash = fnv1a_hash(mmap.data(), mmap.size());
+        cache_entry = parse_cache_path(content_hash, filepath.string());
+        if (load_parse_cache(cache_entry, content_hash, filepath.string(), functions_out,
+                             calls_out, variables_out)) {
+            return true;
+        }
+    }
+
+    // Watch mode keeps one parser per file alive across runs: reparse()
+    // diffs the new content against that file's previous parse so
+    // tree-sitter re-lexes only the edited ranges. Without a cache, full
+    // parse on the per-thread per-language parser.
+    LanguageParser *parser = nullptr;
+    if (config_.parser_cache) {
+        std::lock_guard<std::mutex> lock(config_.parser_cache->mutex);
+        auto &slot = config_.parser_cache->parsers[filepath.string()];
+        if (!slot) {
+            slot = create_parser(lang);
+        }
+        parser = slot.get();
+    }
+    if (parser) {
+        if (!parser->reparse(std::string(mmap.data(), mmap.size())))
+            return false;
+    } else {
+        parser = thread_parser(lang);
+        if (!parser || !parser->parse(mmap.data(), mmap.size()))
+            return false;
+    }
 
     std::string file_prefix = filepath.filename().string();
     size_t dot = file_prefix.rfind('.');
@@ -116,72 +394,108 @@ bool Indexer::parse_file(const fs::path &filepath, std::vector<FunctionInfo> &fu
 
     auto functions = parser->extract_functions();
 
+    // Stable storage for file-scoped C names: FunctionDef views must stay
+    // valid while calls/variables are extracted against the renamed function.
+    std::deque<std::string> c_prefixed_names;
+
     for (auto &func : functions) {
-        if (func.qualified_name.find("::") == std::string::npos &&
-            func.qualified_name.find(".") == std::string::npos) {
+        if (func.qualified_name.find("::") == std::string_view::npos &&
+            func.qualified_name.find(".") == std::string_view::npos) {
             if (lang == Language::C) {
-                func.qualified_name = file_prefix + "::" + func.qualified_name;
+                c_prefixed_names.push_back(file_prefix + "::" +
+                                           std::string(func.qualified_name));
+                func.qualified_name = c_prefixed_names.back();
             }
         }
 
         FunctionInfo info;
-        info.qualified_name = func.qualified_name;
+        info.qualified_name = std::string(func.qualified_name);
         info.file_path = filepath.string();
-        info.param_types = func.param_types;
+        info.param_types.assign(func.param_types.begin(), func.param_types.end());
         functions_out.push_back(std::move(info));
 
         auto calls = parser->extract_calls(func);
         for (const auto &call : calls) {
             CallInfo ci;
-            ci.caller_name = func.qualified_name;
-            ci.callee_name = call.qualified_name.empty() ? call.name : call.qualified_name;
+            ci.caller_name = std::string(func.qualified_name);
+            ci.callee_name =
+                std::string(call.qualified_name.empty() ? call.name : call.qualified_name);
             calls_out.push_back(std::move(ci));
         }
 
         auto vars = parser->extract_variables(func);
         for (const auto &var : vars) {
             VariableInfo vi;
-            vi.qualified_name = var.qualified_name;
-            vi.containing_func = var.containing_func;
-            vi.value_source = var.value_source;
+            vi.qualified_name = std::string(var.qualified_name);
+            vi.containing_func = std::string(var.containing_func);
+            vi.value_source = std::string(var.value_source);
             vi.from_function_call = var.from_function_call;
             variables_out.push_back(std::move(vi));
         }
     }
 
+    if (config_.parse_cache) {
+        save_parse_cache(cache_entry, content_hash, filepath.string(), functions_out, calls_out,
+                         variables_out);
+    }
+
     return true;
 }
 
-void Indexer::worker_parse_files(const std::vector<fs::path> &files, size_t start_idx,
-                                 size_t end_idx, std::vector<FunctionInfo> &all_functions,
-                                 std::vector<CallInfo> &all_calls,
-                                 std::vector<VariableInfo> &all_variables,
-                                 std::mutex &functions_mutex, std::mutex &calls_mutex,
-                                 std::mutex &variables_mutex) {
-    std::vector<FunctionInfo> local_functions;
-    std::vector<CallInfo> local_calls;
-    std::vector<VariableInfo> local_variables;
-    local_functions.reserve(500);
-    local_calls.reserve(2000);
-    local_variables.reserve(1000);
-
-    for (size_t i = start_idx; i < end_idx; ++i) {
-        const auto &filepath = files[i];
+void Indexer::worker_read_files(const std::vector<fs::path> &files,
+                                std::atomic<size_t> &next_index, size_t end_idx,
+                                FileBufferQueue &queue,
+                                std::atomic<unsigned int> &active_readers) {
+    // Small chunks keep the fetch_add overhead negligible while still
+    // balancing well when a few huge files cluster together.
+    constexpr size_t CHUNK_SIZE = 8;
+
+    for (;;) {
+        size_t chunk_start = next_index.fetch_add(CHUNK_SIZE, std::memory_order_relaxed);
+        if (chunk_start >= end_idx)
+            break;
+        size_t chunk_end = std::min(chunk_start + CHUNK_SIZE, end_idx);
+
+        for (size_t i = chunk_start; i < chunk_end; ++i) {
+            FileBuffer buffer;
+            buffer.path = files[i];
+            if (!buffer.mmap.open(buffer.path.string()))
+                continue;
+
+            // Pay the page-fault cost here, on the I/O stage, so parse
+            // workers only ever see resident buffers.
+            buffer.mmap.prefault();
+            queue.push(std::move(buffer));
+        }
+    }
+
+    // Last reader out wakes any parse workers still blocked on pop()
+    if (active_readers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        queue.close();
+    }
+}
+
+void Indexer::worker_parse_files(FileBufferQueue &queue, ParseShard &shard) {
+    shard.functions.reserve(500);
+    shard.calls.reserve(2000);
+    shard.variables.reserve(1000);
 
+    FileBuffer buffer;
+    while (queue.pop(buffer)) {
         std::vector<FunctionInfo> file_functions;
         std::vector<CallInfo> file_calls;
         std::vector<VariableInfo> file_variables;
 
-        if (parse_file(filepath, file_functions, file_calls, file_variables)) {
-            // Accumulate locally
+        if (parse_buffer(buffer.path, buffer.mmap, file_functions, file_calls, file_variables)) {
+            // Accumulate into this worker's own shard - no locking
             for (auto &f : file_functions) {
-                local_functions.push_back(std::move(f));
+                shard.functions.push_back(std::move(f));
             }
             for (auto &c : file_calls) {
-                local_calls.push_back(std::move(c));
+                shard.calls.push_back(std::move(c));
             }
             for (auto &v : file_variables) {
-                local_variables.push_back(std::move(v));
+                shard.variables.push_back(std::move(v));
             }
 
             stats_.files_indexed++;
@@ -191,63 +505,191 @@ void Indexer::worker_parse_files(const std::vector<fs::path> &files, size_t star
 
             {
                 std::lock_guard<std::mutex> lock(output_mutex_);
-                std::cout << "Parsed: " << filepath.string() << std::endl;
+                std::cout << "Parsed: " << buffer.path.string() << std::endl;
             }
         }
+    }
+}
 
-        if (local_functions.size() > 2000) {
-            {
-                std::lock_guard<std::mutex> lock(functions_mutex);
-                all_functions.insert(all_functions.end(),
-                                     std::make_move_iterator(local_functions.begin()),
-                                     std::make_move_iterator(local_functions.end()));
+void Indexer::build_graph_shard(
+    const ParseShard &shard,
+    const std::unordered_map<std::string, std::string> &short_to_qualified, Graph &shard_graph) {
+    for (const auto &func : shard.functions) {
+        shard_graph.add_symbol(func.qualified_name, func.file_path);
+    }
+
+    for (const auto &call : shard.calls) {
+        const std::string &caller = call.caller_name;
+
+        std::string_view callee_view = call.callee_name;
+        size_t pos = callee_view.rfind("::");
+        if (pos != std::string_view::npos) {
+            callee_view = callee_view.substr(pos + 2);
+        }
+        pos = callee_view.rfind('.');
+        if (pos != std::string_view::npos) {
+            callee_view = callee_view.substr(pos + 1);
+        }
+        std::string callee_short(callee_view);
+
+        const std::string *callee_ptr = &call.callee_name;
+        auto it = short_to_qualified.find(callee_short);
+        if (it != short_to_qualified.end()) {
+            callee_ptr = &it->second;
+        }
+
+        if (!shard_graph.has_symbol(*callee_ptr)) {
+            shard_graph.add_symbol(*callee_ptr);
+        }
+        if (!shard_graph.has_symbol(caller)) {
+            shard_graph.add_symbol(caller);
+        }
+
+        shard_graph.add_call(caller, *callee_ptr);
+    }
+
+    for (const auto &var : shard.variables) {
+        // The containing function was parsed by this same worker, so its
+        // file linkage is available in the shard.
+        std::string var_file;
+        auto func_uid = shard_graph.get_uid(var.containing_func);
+        if (func_uid != INVALID_UID) {
+            auto sym_file_uid = shard_graph.get_symbol_file_uid(func_uid);
+            if (sym_file_uid != INVALID_UID) {
+                var_file = shard_graph.get_file_path(sym_file_uid);
             }
-            local_functions.clear();
-            local_functions.reserve(500);
         }
-        if (local_calls.size() > 10000) {
-            {
-                std::lock_guard<std::mutex> lock(calls_mutex);
-                all_calls.insert(all_calls.end(), std::make_move_iterator(local_calls.begin()),
-                                 std::make_move_iterator(local_calls.end()));
+
+        shard_graph.add_symbol(var.qualified_name, var_file, SymbolType::Variable);
+
+        if (!var.value_source.empty()) {
+            const std::string *source_ptr = &var.value_source;
+
+            if (var.from_function_call) {
+                std::string_view source_view = var.value_source;
+                size_t pos = source_view.rfind("::");
+                if (pos != std::string_view::npos) {
+                    source_view = source_view.substr(pos + 2);
+                }
+                pos = source_view.rfind('.');
+                if (pos != std::string_view::npos) {
+                    source_view = source_view.substr(pos + 1);
+                }
+                std::string source_short(source_view);
+
+                auto it = short_to_qualified.find(source_short);
+                if (it != short_to_qualified.end()) {
+                    source_ptr = &it->second;
+                }
+            }
+
+            if (!shard_graph.has_symbol(*source_ptr)) {
+                shard_graph.add_symbol(*source_ptr, var_file,
+                                       var.from_function_call ? SymbolType::Function
+                                                              : SymbolType::Variable);
             }
-            local_calls.clear();
-            local_calls.reserve(2000);
+
+            shard_graph.add_data_flow(*source_ptr, var.qualified_name);
         }
-        if (local_variables.size() > 5000) {
-            {
-                std::lock_guard<std::mutex> lock(variables_mutex);
-                all_variables.insert(all_variables.end(),
-                                     std::make_move_iterator(local_variables.begin()),
-                                     std::make_move_iterator(local_variables.end()));
+    }
+}
+
+void Indexer::merge_shard(Graph &graph, const Graph &shard_graph) {
+    const CallGraph &shard_cg = shard_graph.call_graph;
+    CallGraph &cg = graph.call_graph;
+
+    // Remap shard-local UIDs to global UIDs by symbol name. Symbols first
+    // so edges below can go through the remap table only.
+    std::unordered_map<SymbolUID, SymbolUID> remap;
+    remap.reserve(shard_cg.symbol_to_uid.size());
+
+    for (const auto &[name, shard_uid] : shard_cg.symbol_to_uid) {
+        SymbolUID global_uid = cg.get_or_create_uid(name, shard_cg.get_type(shard_uid));
+        remap[shard_uid] = global_uid;
+
+        auto file_it = shard_cg.symbol_to_file.find(shard_uid);
+        if (file_it != shard_cg.symbol_to_file.end() &&
+            cg.symbol_to_file.find(global_uid) == cg.symbol_to_file.end()) {
+            const std::string &path = shard_graph.get_file_path(file_it->second);
+            if (!path.empty()) {
+                SymbolUID global_file_uid = graph.get_or_create_file_uid(path);
+                cg.symbol_to_file[global_uid] = global_file_uid;
+                cg.file_to_symbols[global_file_uid].push_back(global_uid);
             }
-            local_variables.clear();
-            local_variables.reserve(1000);
         }
     }
 
-    // Final flush
-    if (!local_functions.empty()) {
-        std::lock_guard<std::mutex> lock(functions_mutex);
-        all_functions.insert(all_functions.end(), std::make_move_iterator(local_functions.begin()),
-                             std::make_move_iterator(local_functions.end()));
+    for (const auto &[caller, callees] : shard_cg.call_map) {
+        SymbolUID global_caller = remap[caller];
+        for (SymbolUID callee : callees) {
+            cg.add_call(global_caller, remap[callee]);
+        }
     }
-    if (!local_calls.empty()) {
-        std::lock_guard<std::mutex> lock(calls_mutex);
-        all_calls.insert(all_calls.end(), std::make_move_iterator(local_calls.begin()),
-                         std::make_move_iterator(local_calls.end()));
+
+    for (const auto &[source, dests] : shard_cg.data_flow_map) {
+        SymbolUID global_source = remap[source];
+        for (SymbolUID dest : dests) {
+            cg.add_data_flow(global_source, remap[dest]);
+        }
+    }
+}
+
+// File mtime as a raw tick count; only compared for equality against the
+// value recorded by a previous run on the same machine.
+static int64_t file_mtime(const fs::path &path) {
+    std::error_code ec;
+    auto mtime = fs::last_write_time(path, ec);
+    if (ec)
+        return 0;
+    return static_cast<int64_t>(mtime.time_since_epoch().count());
+}
+
+static uint64_t hash_file(const fs::path &path) {
+    MemoryMappedFile mmap;
+    if (!mmap.open(path.string()))
+        return 0;
+    return fnv1a_hash(mmap.data(), mmap.size());
+}
+
+// Evict a file's symbols from the graph before re-parse (keep_symbols) or
+// after deletion (full removal).
+static void evict_file(Graph &graph, SymbolUID file_uid, bool keep_symbols) {
+    CallGraph &cg = graph.call_graph;
+
+    auto it = cg.file_to_symbols.find(file_uid);
+    if (it != cg.file_to_symbols.end()) {
+        std::vector<SymbolUID> symbols = std::move(it->second);
+        cg.file_to_symbols.erase(it);
+        for (SymbolUID uid : symbols) {
+            if (keep_symbols) {
+                cg.remove_outgoing_edges(uid);
+                cg.symbol_to_file.erase(uid);
+            } else {
+                cg.remove_symbol(uid);
+            }
+        }
     }
-    if (!local_variables.empty()) {
-        std::lock_guard<std::mutex> lock(variables_mutex);
-        all_variables.insert(all_variables.end(), std::make_move_iterator(local_variables.begin()),
-                             std::make_move_iterator(local_variables.end()));
+
+    if (!keep_symbols) {
+        auto path_it = cg.file_uid_to_path_idx.find(file_uid);
+        if (path_it != cg.file_uid_to_path_idx.end()) {
+            cg.filepath_to_uid.erase(cg.filepath_pool.get(path_it->second));
+            cg.file_uid_to_path_idx.erase(path_it);
+        }
+        cg.file_meta.erase(file_uid);
     }
 }
 
-Graph Indexer::index() {
-    Graph graph;
+Graph Indexer::index() { return index(Graph{}); }
 
-    auto files = discover_files();
+Graph Indexer::index(Graph previous) {
+    Graph graph = std::move(previous);
+
+    std::vector<fs::path> files;
+    {
+        prof::ScopedTimer timer("index.discover");
+        files = discover_files();
+    }
     if (files.empty()) {
         std::cout << "No source files found to index." << std::endl;
         return graph;
@@ -256,150 +698,201 @@ Graph Indexer::index() {
     std::cout << "Found " << files.size() << " source files to index." << std::endl;
     std::cout << "Using " << config_.num_threads << " threads." << std::endl;
 
-    const size_t BATCH_SIZE = files.size() > 50000 ? 2000 : files.size() > 10000 ? 5000 : 10000;
+    // Decide which files actually need a parse. With no previous metadata
+    // (fresh index) everything is parsed; otherwise only new files and files
+    // whose mtime and content hash both changed.
+    std::vector<fs::path> to_parse;
+    std::unordered_map<std::string, FileMeta> fresh_meta;
+    fresh_meta.reserve(files.size());
+
+    if (!graph.call_graph.file_meta.empty()) {
+        CallGraph &cg = graph.call_graph;
+        std::unordered_set<std::string> discovered;
+        discovered.reserve(files.size());
+        size_t unchanged = 0;
+
+        for (const auto &file : files) {
+            std::string path_str = file.string();
+            discovered.insert(path_str);
+            int64_t mtime = file_mtime(file);
+
+            auto uid_it = cg.filepath_to_uid.find(path_str);
+            if (uid_it == cg.filepath_to_uid.end()) {
+                to_parse.push_back(file);
+                continue;
+            }
+
+            auto meta_it = cg.file_meta.find(uid_it->second);
+            if (meta_it != cg.file_meta.end() && meta_it->second.mtime == mtime) {
+                fresh_meta[path_str] = meta_it->second;
+                unchanged++;
+                continue;
+            }
+
+            uint64_t hash = hash_file(file);
+            if (meta_it != cg.file_meta.end() && meta_it->second.hash == hash) {
+                // Touched but content identical - just refresh the mtime.
+                fresh_meta[path_str] = {mtime, hash};
+                unchanged++;
+                continue;
+            }
+
+            evict_file(graph, uid_it->second, /*keep_symbols=*/true);
+            fresh_meta[path_str] = {mtime, hash};
+            to_parse.push_back(file);
+        }
+
+        // Files present in the previous index but gone from disk.
+        std::vector<SymbolUID> deleted;
+        for (const auto &[path, file_uid] : cg.filepath_to_uid) {
+            if (!discovered.count(path)) {
+                deleted.push_back(file_uid);
+            }
+        }
+        for (SymbolUID file_uid : deleted) {
+            // Drop the deleted file's cached parser too, or the watch
+            // daemon would hold its tree and source for the rest of its life
+            if (config_.parser_cache) {
+                std::string path = graph.get_file_path(file_uid);
+                std::lock_guard<std::mutex> lock(config_.parser_cache->mutex);
+                config_.parser_cache->parsers.erase(path);
+            }
+            evict_file(graph, file_uid, /*keep_symbols=*/false);
+        }
+
+        std::cout << "Incremental: " << unchanged << " unchanged, " << to_parse.size()
+                  << " to re-parse, " << deleted.size() << " deleted." << std::endl;
+
+        if (to_parse.empty() && deleted.empty()) {
+            indexed_files_.reserve(files.size());
+            for (const auto &f : files) {
+                indexed_files_.push_back(f.string());
+            }
+            std::cout << "Index is up to date." << std::endl;
+            return graph;
+        }
+    } else {
+        to_parse = files;
+    }
+
+    const size_t BATCH_SIZE =
+        to_parse.size() > 50000 ? 2000 : to_parse.size() > 10000 ? 5000 : 10000;
 
     std::cout << "Processing in batches of " << BATCH_SIZE << " files." << std::endl;
 
     std::unordered_map<std::string, std::string> short_to_qualified;
     short_to_qualified.reserve(std::min(files.size() * 5, (size_t)500000));
 
-    size_t total_batches = (files.size() + BATCH_SIZE - 1) / BATCH_SIZE;
+    // On an incremental run, callees in re-parsed files may resolve to
+    // functions that live in unchanged files - seed the short name mapping
+    // from the symbols already in the graph.
+    for (const auto &[name, uid] : graph.call_graph.symbol_to_uid) {
+        if (graph.call_graph.get_type(uid) != SymbolType::Function)
+            continue;
+        std::string short_name = name;
+        size_t last_sep = short_name.rfind("::");
+        if (last_sep != std::string::npos) {
+            short_name = short_name.substr(last_sep + 2);
+        }
+        if (short_to_qualified.find(short_name) == short_to_qualified.end()) {
+            short_to_qualified[short_name] = name;
+        }
+    }
+
+    size_t total_batches = (to_parse.size() + BATCH_SIZE - 1) / BATCH_SIZE;
 
     for (size_t batch = 0; batch < total_batches; ++batch) {
         size_t batch_start = batch * BATCH_SIZE;
-        size_t batch_end = std::min(batch_start + BATCH_SIZE, files.size());
+        size_t batch_end = std::min(batch_start + BATCH_SIZE, to_parse.size());
         size_t batch_file_count = batch_end - batch_start;
 
         std::cout << "\n=== Batch " << (batch + 1) << "/" << total_batches << " (files "
                   << batch_start << "-" << batch_end << ") ===" << std::endl;
 
-        std::vector<FunctionInfo> batch_functions;
-        std::vector<CallInfo> batch_calls;
-        std::vector<VariableInfo> batch_variables;
-        std::mutex functions_mutex, calls_mutex, variables_mutex;
+        unsigned int worker_count =
+            static_cast<unsigned int>(std::min<size_t>(config_.num_threads, batch_file_count));
 
-        batch_functions.reserve(batch_file_count * 10);
-        batch_calls.reserve(batch_file_count * 50);
-        batch_variables.reserve(batch_file_count * 25);
+        // Parsing dominates, so most threads go to it; a few dedicated
+        // readers are enough to keep the buffer queue full on cold caches.
+        unsigned int reader_count = std::clamp(worker_count / 4, 1u, 4u);
 
+        std::vector<ParseShard> shards(worker_count);
+        std::vector<std::thread> readers;
         std::vector<std::thread> threads;
-        size_t files_per_thread =
-            (batch_file_count + config_.num_threads - 1) / config_.num_threads;
-
-        for (unsigned int t = 0; t < config_.num_threads; ++t) {
-            size_t start_idx = batch_start + t * files_per_thread;
-            size_t end_idx = std::min(start_idx + files_per_thread, batch_end);
+        std::atomic<size_t> next_index{batch_start};
+        std::atomic<unsigned int> active_readers{reader_count};
+        FileBufferQueue queue(64);
 
-            if (start_idx >= batch_end)
-                break;
+        {
+            prof::ScopedTimer timer("index.parse");
 
-            threads.emplace_back(&Indexer::worker_parse_files, this, std::cref(files), start_idx,
-                                 end_idx, std::ref(batch_functions), std::ref(batch_calls),
-                                 std::ref(batch_variables), std::ref(functions_mutex),
-                                 std::ref(calls_mutex), std::ref(variables_mutex));
-        }
-
-        for (auto &t : threads) {
-            t.join();
-        }
-
-        std::cout << "Batch parsed: " << batch_functions.size() << " functions, "
-                  << batch_calls.size() << " calls, " << batch_variables.size() << " variables."
-                  << std::endl;
-
-        // Process this batch: add functions to graph and build short name mapping
-        for (const auto &func : batch_functions) {
-            graph.add_symbol(func.qualified_name, func.file_path);
-
-            std::string short_name = func.qualified_name;
-            size_t last_sep = short_name.rfind("::");
-            if (last_sep != std::string::npos) {
-                short_name = short_name.substr(last_sep + 2);
+            for (unsigned int t = 0; t < reader_count; ++t) {
+                readers.emplace_back(&Indexer::worker_read_files, this, std::cref(to_parse),
+                                     std::ref(next_index), batch_end, std::ref(queue),
+                                     std::ref(active_readers));
             }
-            if (short_to_qualified.find(short_name) == short_to_qualified.end()) {
-                short_to_qualified[short_name] = func.qualified_name;
+            for (unsigned int t = 0; t < worker_count; ++t) {
+                threads.emplace_back(&Indexer::worker_parse_files, this, std::ref(queue),
+                                     std::ref(shards[t]));
             }
-        }
-
-        for (const auto &call : batch_calls) {
-            const std::string &caller = call.caller_name;
 
-            std::string_view callee_view = call.callee_name;
-            size_t pos = callee_view.rfind("::");
-            if (pos != std::string_view::npos) {
-                callee_view = callee_view.substr(pos + 2);
+            for (auto &t : readers) {
+                t.join();
             }
-            pos = callee_view.rfind('.');
-            if (pos != std::string_view::npos) {
-                callee_view = callee_view.substr(pos + 1);
+            for (auto &t : threads) {
+                t.join();
             }
-            std::string callee_short(callee_view);
+            threads.clear();
+        }
 
-            const std::string *callee_ptr = &call.callee_name;
-            auto it = short_to_qualified.find(callee_short);
-            if (it != short_to_qualified.end()) {
-                callee_ptr = &it->second;
+        size_t parsed_functions = 0, parsed_calls = 0, parsed_variables = 0;
+        for (const auto &shard : shards) {
+            parsed_functions += shard.functions.size();
+            parsed_calls += shard.calls.size();
+            parsed_variables += shard.variables.size();
+        }
+        std::cout << "Batch parsed: " << parsed_functions << " functions, " << parsed_calls
+                  << " calls, " << parsed_variables << " variables." << std::endl;
+
+        // Short name resolution needs the full batch, so extend the global
+        // mapping before shard graphs are built against it (read-only).
+        for (const auto &shard : shards) {
+            for (const auto &func : shard.functions) {
+                std::string short_name = func.qualified_name;
+                size_t last_sep = short_name.rfind("::");
+                if (last_sep != std::string::npos) {
+                    short_name = short_name.substr(last_sep + 2);
+                }
+                if (short_to_qualified.find(short_name) == short_to_qualified.end()) {
+                    short_to_qualified[short_name] = func.qualified_name;
+                }
             }
+        }
 
-            if (!graph.has_symbol(*callee_ptr)) {
-                graph.add_symbol(*callee_ptr);
+        // Build per-thread graph shards in parallel, each with its own
+        // StringPool and UID space.
+        std::vector<Graph> shard_graphs(worker_count);
+        {
+            prof::ScopedTimer timer("index.build_shards");
+            for (unsigned int t = 0; t < worker_count; ++t) {
+                threads.emplace_back(&Indexer::build_graph_shard, std::cref(shards[t]),
+                                     std::cref(short_to_qualified), std::ref(shard_graphs[t]));
             }
-            if (!graph.has_symbol(caller)) {
-                graph.add_symbol(caller);
+            for (auto &t : threads) {
+                t.join();
             }
-
-            graph.add_call(caller, *callee_ptr);
         }
 
-        for (const auto &var : batch_variables) {
-            std::string var_file;
-            auto file_uid = graph.get_uid(var.containing_func);
-            if (file_uid != INVALID_UID) {
-                auto sym_file_uid = graph.get_symbol_file_uid(file_uid);
-                if (sym_file_uid != INVALID_UID) {
-                    var_file = graph.get_file_path(sym_file_uid);
-                }
-            }
-
-            graph.add_symbol(var.qualified_name, var_file, SymbolType::Variable);
-
-            if (!var.value_source.empty()) {
-                const std::string *source_ptr = &var.value_source;
-
-                if (var.from_function_call) {
-                    std::string_view source_view = var.value_source;
-                    size_t pos = source_view.rfind("::");
-                    if (pos != std::string_view::npos) {
-                        source_view = source_view.substr(pos + 2);
-                    }
-                    pos = source_view.rfind('.');
-                    if (pos != std::string_view::npos) {
-                        source_view = source_view.substr(pos + 1);
-                    }
-                    std::string source_short(source_view);
-
-                    auto it = short_to_qualified.find(source_short);
-                    if (it != short_to_qualified.end()) {
-                        source_ptr = &it->second;
-                    }
-                }
-
-                if (!graph.has_symbol(*source_ptr)) {
-                    graph.add_symbol(*source_ptr, var_file,
-                                     var.from_function_call ? SymbolType::Function
-                                                            : SymbolType::Variable);
-                }
-
-                graph.add_data_flow(*source_ptr, var.qualified_name);
+        // Merge shards, remapping shard-local UIDs to global ones.
+        {
+            prof::ScopedTimer timer("index.merge");
+            for (const auto &shard_graph : shard_graphs) {
+                merge_shard(graph, shard_graph);
             }
         }
 
-        batch_functions.clear();
-        std::vector<FunctionInfo>().swap(batch_functions);
-        batch_calls.clear();
-        std::vector<CallInfo>().swap(batch_calls);
-        batch_variables.clear();
-        std::vector<VariableInfo>().swap(batch_variables);
+        std::vector<ParseShard>().swap(shards);
+        std::vector<Graph>().swap(shard_graphs);
 
         std::cout << "Batch " << (batch + 1) << " complete." << std::endl;
     }
@@ -407,6 +900,24 @@ Graph Indexer::index() {
     short_to_qualified.clear();
     std::unordered_map<std::string, std::string>().swap(short_to_qualified);
 
+    // Record freshness metadata for every discovered file so the next run
+    // can index incrementally. Hashes carried over from an unchanged file
+    // are reused; everything else is hashed now (the pages are still warm).
+    {
+        prof::ScopedTimer timer("index.file_meta");
+        for (const auto &file : files) {
+            std::string path_str = file.string();
+            SymbolUID file_uid = graph.get_or_create_file_uid(path_str);
+
+            auto it = fresh_meta.find(path_str);
+            if (it != fresh_meta.end() && it->second.hash != 0) {
+                graph.call_graph.file_meta[file_uid] = it->second;
+            } else {
+                graph.call_graph.file_meta[file_uid] = {file_mtime(file), hash_file(file)};
+            }
+        }
+    }
+
     indexed_files_.reserve(files.size());
     for (const auto &f : files) {
         indexed_files_.push_back(f.string());
@@ -16,6 +16,8 @@
 #include <iostream>
 
 #include "pioneer/commands.hpp"
+#include "pioneer/daemon.hpp"
+#include "pioneer/profile.hpp"
 #include "pioneer/version.hpp"
 
 using namespace pioneer;
@@ -41,6 +43,10 @@ int main(int argc, char *argv[]) {
     opts("h,help", "Print help");
     opts("v,version", "Print version");
     opts("index", "Build call graph index for current directory");
+    opts("incremental", "Re-parse only files changed since the last index");
+    opts("daemon", "Keep the graph resident and serve queries over a unix socket");
+    opts("watch", "Run the daemon and re-index incrementally as source files change");
+    opts("daemon-stop", "Stop a running daemon");
     opts("j,jobs", "Number of threads for indexing (0 = auto)",
          cxxopts::value<unsigned int>()->default_value("0"));
     opts("s,start", "Start symbol chain (comma-separated, no spaces)",
@@ -48,7 +54,16 @@ int main(int argc, char *argv[]) {
     opts("e,end", "End symbol chain (comma-separated, no spaces)",
          cxxopts::value<std::vector<std::string>>());
     opts("b,backtrace", "Enable backtrace mode (find all callers)");
+    opts("shortest", "Report only the k shortest paths (default 10) instead of every path",
+         cxxopts::value<size_t>()->default_value("0")->implicit_value("10"));
+    opts("exclude-hubs", "Skip symbols with more than N callers+callees during path searches",
+         cxxopts::value<uint32_t>()->default_value("0"));
+    opts("scope", "Restrict path searches and --search to symbols under this directory",
+         cxxopts::value<std::string>()->default_value(""));
+    opts("with-index", "Merge additional shard index files into the loaded graph (repeatable)",
+         cxxopts::value<std::vector<std::string>>());
 
+    opts("stats", "Print index statistics from the metadata header (no graph load)");
     opts("l,list", "List all indexed symbols");
     opts("caller", "Find immediate callers of symbol (comma-separated, no spaces)",
          cxxopts::value<std::vector<std::string>>());
@@ -62,8 +77,12 @@ int main(int argc, char *argv[]) {
          cxxopts::value<std::vector<std::string>>());
     opts("member", "Find member assignments (comma-separated, no spaces)",
          cxxopts::value<std::vector<std::string>>());
+    opts("reachable", "Check reachability from the first symbol to the rest (comma-separated)",
+         cxxopts::value<std::vector<std::string>>());
     opts("search", "Search symbols (comma-separated, no spaces)",
          cxxopts::value<std::vector<std::string>>());
+    opts("batch", "Run JSONL queries from file against one index load",
+         cxxopts::value<std::string>());
     opts("grep", "Search pattern in source files", cxxopts::value<std::string>());
     opts("regex", "Use regex for grep (instead of plain text)");
     opts("ignore-case", "Case-insensitive grep");
@@ -72,6 +91,8 @@ int main(int argc, char *argv[]) {
     opts("nosort", "Do not sort the list of symbols");
     opts("type", "Prints type of symbol (function/variable)",
          cxxopts::value<std::string>()->default_value(""));
+    opts("profile", "Print phase timings and counters on exit ('json' for machine-readable)",
+         cxxopts::value<std::string>()->default_value("")->implicit_value("text"));
 
     try {
         auto result = options.parse(argc, argv);
@@ -84,8 +105,20 @@ int main(int argc, char *argv[]) {
                       << std::endl;
             std::cout << "  pioneer --index -j 8               Build index using 8 threads"
                       << std::endl;
+            std::cout << "  pioneer --index --incremental      Re-parse only changed files"
+                      << std::endl;
+            std::cout << "  pioneer --daemon                   Serve queries from a resident graph"
+                      << std::endl;
+            std::cout << "  pioneer --watch                    Daemon plus re-index on file change"
+                      << std::endl;
+            std::cout << "  pioneer --batch queries.jsonl      Run many queries on one index load"
+                      << std::endl;
+            std::cout << "  pioneer --stats                    Index statistics from the header"
+                      << std::endl;
             std::cout << "  pioneer --start foo --end bar      Find paths from foo to bar"
                       << std::endl;
+            std::cout << "  pioneer --start foo --end bar --shortest 5   Only the 5 shortest paths"
+                      << std::endl;
             std::cout << "  pioneer --start foo --end END      Find all call paths from foo"
                       << std::endl;
             std::cout << "  pioneer --start START --end bar    Backtrace: find all callers of bar"
@@ -119,6 +152,9 @@ int main(int argc, char *argv[]) {
                       << std::endl;
             std::cout << "  pioneer --member 'dev->field'      Find ALL assignments to dev->field"
                       << std::endl;
+            std::cout << "  pioneer --reachable 'X,a,b'        Check if a and b are reachable "
+                         "from X"
+                      << std::endl;
             return 0;
         }
 
@@ -127,12 +163,68 @@ int main(int argc, char *argv[]) {
             return 0;
         }
 
+        // Report goes to stderr on every return path below, so command
+        // output on stdout stays clean for pipes.
+        std::string profile_mode = result["profile"].as<std::string>();
+        prof::set_enabled(!profile_mode.empty());
+        struct ProfileReport {
+            bool json;
+            ~ProfileReport() {
+                if (prof::enabled()) {
+                    prof::report(std::cerr, json);
+                }
+            }
+        } profile_report{profile_mode == "json"};
+
+        // Federated shard indexes apply to every graph load below,
+        // including a daemon's resident graph
+        if (result.count("with-index")) {
+            set_federated_indexes(result["with-index"].as<std::vector<std::string>>());
+        }
+
+        if (result.count("daemon") || result.count("watch")) {
+            return cmd_daemon(result.count("watch") > 0);
+        }
+
+        if (result.count("daemon-stop")) {
+            return cmd_daemon_stop();
+        }
+
         bool nosort = result.count("nosort") > 0;
         bool show_path = result.count("path") > 0;
 
+        // Forward query commands to a resident daemon when one is serving
+        // this directory; fall back to local execution if the handoff fails.
+        bool forwardable = result.count("list") || result.count("search") ||
+                           result.count("caller") || result.count("callee") ||
+                           result.count("data-sources") || result.count("data-sinks") ||
+                           result.count("vars") || result.count("member") ||
+                           result.count("reachable") ||
+                           result.count("start") || result.count("end") ||
+                           result.count("backtrace") ||
+                           (result.count("type") && !result["type"].as<std::string>().empty());
+        // A resident daemon serves its own (possibly unfederated) graph, so
+        // invocations naming extra shards must run locally
+        if (forwardable && !result.count("with-index") && daemon_running()) {
+            std::vector<std::string> args(argv + 1, argv + argc);
+            int code = forward_to_daemon(args);
+            if (code >= 0) {
+                return code;
+            }
+        }
+
         if (result.count("index")) {
             unsigned int num_threads = result["jobs"].as<unsigned int>();
-            return cmd_index(num_threads);
+            bool incremental = result.count("incremental") > 0;
+            return cmd_index(num_threads, incremental);
+        }
+
+        if (result.count("batch")) {
+            return cmd_batch(result["batch"].as<std::string>());
+        }
+
+        if (result.count("stats")) {
+            return cmd_stats();
         }
 
         if (result.count("list")) {
@@ -149,16 +241,18 @@ int main(int argc, char *argv[]) {
         if (result.count("search")) {
             auto patterns = result["search"].as<std::vector<std::string>>();
             if (!patterns.empty()) {
-                // Use streaming search when show_path not needed (much lower memory)
-                if (!show_path) {
+                std::string scope = result["scope"].as<std::string>();
+                // Use streaming search when neither file paths nor scope
+                // filtering are needed (much lower memory)
+                if (!show_path && scope.empty()) {
                     return cmd_search_streaming(patterns, nosort);
                 }
-                // Fall back to full load for --show-path
+                // Fall back to full load for --path / --scope
                 Graph graph;
                 if (!load_graph(graph, LoadMode::WithPaths)) {
                     return 1;
                 }
-                return cmd_search(patterns, nosort, show_path, graph);
+                return cmd_search(patterns, nosort, show_path, scope, graph);
             }
         }
 
@@ -208,6 +302,12 @@ int main(int argc, char *argv[]) {
                 return cmd_find_member(patterns, nosort);
         }
 
+        if (result.count("reachable")) {
+            auto symbols = result["reachable"].as<std::vector<std::string>>();
+            if (!symbols.empty())
+                return cmd_reachable(symbols);
+        }
+
         std::vector<std::string> start_chain, end_chain;
         if (result.count("start"))
             start_chain = result["start"].as<std::vector<std::string>>();
@@ -217,7 +317,11 @@ int main(int argc, char *argv[]) {
         bool pattern_match = result.count("pattern") > 0;
 
         if (!start_chain.empty() || !end_chain.empty() || backtrace) {
-            return cmd_query(start_chain, end_chain, backtrace, pattern_match, nosort, show_path);
+            size_t shortest_k = result["shortest"].as<size_t>();
+            uint32_t exclude_hubs = result["exclude-hubs"].as<uint32_t>();
+            std::string scope = result["scope"].as<std::string>();
+            return cmd_query(start_chain, end_chain, backtrace, pattern_match, nosort, show_path,
+                             shortest_k, exclude_hubs, scope);
         }
 
         print_banner();
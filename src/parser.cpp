@@ -46,9 +46,14 @@ LanguageParser::LanguageParser(Language lang) : language_(lang) {
         ts_parser_delete(parser_);
         throw std::runtime_error("Failed to set parser language");
     }
+
+    queries_ = &compiled_queries(lang, ts_lang);
+    cursor_ = ts_query_cursor_new();
 }
 
 LanguageParser::~LanguageParser() {
+    if (cursor_)
+        ts_query_cursor_delete(cursor_);
     if (tree_)
         ts_tree_delete(tree_);
     if (parser_)
@@ -58,15 +63,19 @@ LanguageParser::~LanguageParser() {
 LanguageParser::LanguageParser(LanguageParser &&other) noexcept
     : language_(other.language_), parser_(other.parser_), tree_(other.tree_),
       source_(std::move(other.source_)), source_ptr_(other.source_ptr_),
-      source_len_(other.source_len_) {
+      source_len_(other.source_len_), queries_(other.queries_), cursor_(other.cursor_) {
     other.parser_ = nullptr;
     other.tree_ = nullptr;
     other.source_ptr_ = nullptr;
     other.source_len_ = 0;
+    other.queries_ = nullptr;
+    other.cursor_ = nullptr;
 }
 
 LanguageParser &LanguageParser::operator=(LanguageParser &&other) noexcept {
     if (this != &other) {
+        if (cursor_)
+            ts_query_cursor_delete(cursor_);
         if (tree_)
             ts_tree_delete(tree_);
         if (parser_)
@@ -78,11 +87,15 @@ LanguageParser &LanguageParser::operator=(LanguageParser &&other) noexcept {
         source_ = std::move(other.source_);
         source_ptr_ = other.source_ptr_;
         source_len_ = other.source_len_;
+        queries_ = other.queries_;
+        cursor_ = other.cursor_;
 
         other.parser_ = nullptr;
         other.tree_ = nullptr;
         other.source_ptr_ = nullptr;
         other.source_len_ = 0;
+        other.queries_ = nullptr;
+        other.cursor_ = nullptr;
     }
     return *this;
 }
@@ -97,6 +110,7 @@ bool LanguageParser::parse(const std::string &source) {
         tree_ = nullptr;
     }
 
+    arena_.reset();
     tree_ = ts_parser_parse_string(parser_, nullptr, source_ptr_, source_len_);
     return tree_ != nullptr;
 }
@@ -112,10 +126,70 @@ bool LanguageParser::parse(const char *data, size_t length) {
         tree_ = nullptr;
     }
 
+    arena_.reset();
     tree_ = ts_parser_parse_string(parser_, nullptr, source_ptr_, source_len_);
     return tree_ != nullptr;
 }
 
+bool LanguageParser::reparse(const std::string &source) {
+    if (!tree_ || (source_.empty() && source_len_ > 0)) {
+        return parse(source);
+    }
+
+    const std::string &old_src = source_;
+
+    // Single-edit diff: longest common prefix, then longest common suffix
+    // of the remainders. Typical edits touch one region, so this covers the
+    // change tightly; a scattered edit just widens the damaged range.
+    size_t prefix = 0;
+    size_t max_prefix = std::min(old_src.size(), source.size());
+    while (prefix < max_prefix && old_src[prefix] == source[prefix]) {
+        prefix++;
+    }
+
+    size_t suffix = 0;
+    size_t max_suffix = std::min(old_src.size(), source.size()) - prefix;
+    while (suffix < max_suffix &&
+           old_src[old_src.size() - 1 - suffix] == source[source.size() - 1 - suffix]) {
+        suffix++;
+    }
+
+    auto point_at = [](const std::string &text, size_t byte) {
+        TSPoint p{0, 0};
+        for (size_t i = 0; i < byte; ++i) {
+            if (text[i] == '\n') {
+                p.row++;
+                p.column = 0;
+            } else {
+                p.column++;
+            }
+        }
+        return p;
+    };
+
+    TSInputEdit edit;
+    edit.start_byte = static_cast<uint32_t>(prefix);
+    edit.old_end_byte = static_cast<uint32_t>(old_src.size() - suffix);
+    edit.new_end_byte = static_cast<uint32_t>(source.size() - suffix);
+    edit.start_point = point_at(old_src, prefix);
+    edit.old_end_point = point_at(old_src, old_src.size() - suffix);
+    edit.new_end_point = point_at(source, source.size() - suffix);
+    ts_tree_edit(tree_, &edit);
+
+    source_ = source;
+    source_ptr_ = source_.c_str();
+    source_len_ = source_.size();
+
+    arena_.reset();
+    TSTree *new_tree = ts_parser_parse_string(parser_, tree_, source_ptr_, source_len_);
+    if (!new_tree) {
+        return false;
+    }
+    ts_tree_delete(tree_);
+    tree_ = new_tree;
+    return true;
+}
+
 TSNode LanguageParser::root() const {
     if (!tree_) {
         return TSNode{};
@@ -123,37 +197,121 @@ TSNode LanguageParser::root() const {
     return ts_tree_root_node(tree_);
 }
 
-std::string LanguageParser::node_text(TSNode node) const {
+std::string_view LanguageParser::node_text(TSNode node) const {
     uint32_t start = ts_node_start_byte(node);
     uint32_t end = ts_node_end_byte(node);
     if (source_ptr_ && start < source_len_ && end <= source_len_) {
-        return std::string(source_ptr_ + start, end - start);
+        return std::string_view(source_ptr_ + start, end - start);
+    }
+    return {};
+}
+
+// S-expression patterns for the three extraction passes, per language. The
+// tree-sitter query engine only visits subtrees that can match, so these
+// replace the former full-tree visit_nodes() walks (one std::function call
+// per AST node, three times per file).
+namespace {
+
+struct QuerySources {
+    const char *functions;
+    const char *calls;
+    const char *variables;
+};
+
+constexpr QuerySources PYTHON_QUERIES = {
+    "[(class_definition) @class (function_definition) @func]",
+    "(call) @call",
+    "[(assignment) @assign (augmented_assignment) @augassign]",
+};
+
+constexpr QuerySources C_QUERIES = {
+    "(function_definition) @func",
+    "(call_expression) @call",
+    "[(declaration) @decl (assignment_expression) @assign]",
+};
+
+constexpr QuerySources CPP_QUERIES = {
+    "[(namespace_definition) @namespace (class_specifier) @class"
+    " (struct_specifier) @class (function_definition) @func]",
+    "[(call_expression) @call (new_expression) @new]",
+    "[(declaration) @decl (assignment_expression) @assign]",
+};
+
+TSQuery *compile_query(const TSLanguage *ts_lang, const char *source) {
+    uint32_t error_offset = 0;
+    TSQueryError error_type = TSQueryErrorNone;
+    TSQuery *query = ts_query_new(ts_lang, source, static_cast<uint32_t>(strlen(source)),
+                                  &error_offset, &error_type);
+    if (!query) {
+        throw std::runtime_error("Failed to compile tree-sitter query at offset " +
+                                 std::to_string(error_offset) + ": " + source);
     }
-    return "";
+    return query;
 }
 
-void LanguageParser::visit_nodes(TSNode node, const std::function<void(TSNode)> &visitor) const {
-    // Use iterative approach with explicit stack to avoid recursion
-    std::vector<TSNode> stack;
-    stack.push_back(node);
+// Map every capture name in `query` onto the CompiledQueries id fields.
+void resolve_captures(const TSQuery *query, CompiledQueries &out) {
+    uint32_t count = ts_query_capture_count(query);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t length = 0;
+        const char *name = ts_query_capture_name_for_id(query, i, &length);
+        std::string capture(name, length);
+
+        if (capture == "func")
+            out.func_capture = i;
+        else if (capture == "class")
+            out.class_capture = i;
+        else if (capture == "namespace")
+            out.namespace_capture = i;
+        else if (capture == "call")
+            out.call_capture = i;
+        else if (capture == "new")
+            out.new_capture = i;
+        else if (capture == "decl")
+            out.decl_capture = i;
+        else if (capture == "assign")
+            out.assign_capture = i;
+        else if (capture == "augassign")
+            out.aug_assign_capture = i;
+    }
+}
 
-    while (!stack.empty()) {
-        TSNode current = stack.back();
-        stack.pop_back();
+CompiledQueries compile_queries(const QuerySources &sources, const TSLanguage *ts_lang) {
+    CompiledQueries queries;
+    queries.functions = compile_query(ts_lang, sources.functions);
+    queries.calls = compile_query(ts_lang, sources.calls);
+    queries.variables = compile_query(ts_lang, sources.variables);
+    resolve_captures(queries.functions, queries);
+    resolve_captures(queries.calls, queries);
+    resolve_captures(queries.variables, queries);
+    return queries;
+}
 
-        visitor(current);
+} // namespace
 
-        uint32_t child_count = ts_node_child_count(current);
-        // Add children in reverse order so they're processed in order
-        for (uint32_t i = child_count; i > 0; --i) {
-            stack.push_back(ts_node_child(current, i - 1));
-        }
+// Thread-safe one-time compilation per language (magic statics); the query
+// objects live for the process lifetime and are shared by all parsers.
+const CompiledQueries &LanguageParser::compiled_queries(Language lang, const TSLanguage *ts_lang) {
+    switch (lang) {
+    case Language::Python: {
+        static const CompiledQueries queries = compile_queries(PYTHON_QUERIES, ts_lang);
+        return queries;
+    }
+    case Language::C: {
+        static const CompiledQueries queries = compile_queries(C_QUERIES, ts_lang);
+        return queries;
+    }
+    case Language::Cpp:
+    default: {
+        static const CompiledQueries queries = compile_queries(CPP_QUERIES, ts_lang);
+        return queries;
+    }
     }
 }
 
-std::string
-LanguageParser::build_qualified_name(const std::string &base_name,
-                                     const std::vector<std::string> &param_types) const {
+std::string_view
+LanguageParser::build_qualified_name(std::string_view base_name,
+                                     const std::vector<std::string_view> &param_types) const {
     // Just return base name - overload signatures added by indexer if needed
     (void)param_types; // Unused here, handled by indexer
     return base_name;
@@ -243,13 +401,17 @@ std::vector<FunctionDef> LanguageParser::extract_functions_python() const {
 
     // Track class context using a stack
     struct Context {
-        std::string class_name;
+        std::string_view class_name;
         uint32_t end_byte;
     };
     std::vector<Context> class_stack;
 
-    visit_nodes(root(), [&](TSNode node) {
-        const char *type = ts_node_type(node);
+    ts_query_cursor_exec(cursor_, queries_->functions, root());
+    TSQueryMatch match;
+    uint32_t capture_index;
+    while (ts_query_cursor_next_capture(cursor_, &match, &capture_index)) {
+        const TSQueryCapture &capture = match.captures[capture_index];
+        TSNode node = capture.node;
         uint32_t start_byte = ts_node_start_byte(node);
 
         // Pop classes that we've exited
@@ -257,7 +419,7 @@ std::vector<FunctionDef> LanguageParser::extract_functions_python() const {
             class_stack.pop_back();
         }
 
-        if (strcmp(type, "class_definition") == 0) {
+        if (capture.index == queries_->class_capture) {
             // Get class name
             TSNode name_node = ts_node_child_by_field_name(node, "name", 4);
             if (!ts_node_is_null(name_node)) {
@@ -266,7 +428,7 @@ std::vector<FunctionDef> LanguageParser::extract_functions_python() const {
                 ctx.end_byte = ts_node_end_byte(node);
                 class_stack.push_back(ctx);
             }
-        } else if (strcmp(type, "function_definition") == 0) {
+        } else {
             FunctionDef func;
 
             // Get function name
@@ -293,21 +455,22 @@ std::vector<FunctionDef> LanguageParser::extract_functions_python() const {
                 }
             }
 
-            // Build qualified name
-            std::string prefix;
+            // Build qualified name; methods get an arena-backed class prefix,
+            // free functions reference the source directly
             if (!class_stack.empty()) {
                 func.containing_class = class_stack.back().class_name;
-                prefix = func.containing_class + ".";
+                func.qualified_name = arena_.concat(
+                    func.containing_class, ".", build_qualified_name(func.name, func.param_types));
+            } else {
+                func.qualified_name = build_qualified_name(func.name, func.param_types);
             }
-
-            func.qualified_name = prefix + build_qualified_name(func.name, func.param_types);
             func.start_line = ts_node_start_point(node).row + 1;
             func.end_line = ts_node_end_point(node).row + 1;
             func.node = node;
 
             functions.push_back(func);
         }
-    });
+    }
 
     return functions;
 }
@@ -315,33 +478,34 @@ std::vector<FunctionDef> LanguageParser::extract_functions_python() const {
 std::vector<FunctionCall> LanguageParser::extract_calls_python(const FunctionDef &func) const {
     std::vector<FunctionCall> calls;
 
-    visit_nodes(func.node, [&](TSNode node) {
-        const char *type = ts_node_type(node);
+    ts_query_cursor_exec(cursor_, queries_->calls, func.node);
+    TSQueryMatch match;
+    uint32_t capture_index;
+    while (ts_query_cursor_next_capture(cursor_, &match, &capture_index)) {
+        TSNode node = match.captures[capture_index].node;
 
-        if (strcmp(type, "call") == 0) {
-            FunctionCall call;
-            call.line = ts_node_start_point(node).row + 1;
-            call.node = node;
+        FunctionCall call;
+        call.line = ts_node_start_point(node).row + 1;
+        call.node = node;
 
-            TSNode func_node = ts_node_child_by_field_name(node, "function", 8);
-            if (!ts_node_is_null(func_node)) {
-                const char *func_type = ts_node_type(func_node);
+        TSNode func_node = ts_node_child_by_field_name(node, "function", 8);
+        if (!ts_node_is_null(func_node)) {
+            const char *func_type = ts_node_type(func_node);
 
-                if (strcmp(func_type, "identifier") == 0) {
-                    call.name = node_text(func_node);
-                    call.qualified_name = call.name;
-                } else if (strcmp(func_type, "attribute") == 0) {
-                    // obj.method() - get the full attribute chain
-                    call.name = node_text(func_node);
-                    call.qualified_name = call.name;
-                }
+            if (strcmp(func_type, "identifier") == 0) {
+                call.name = node_text(func_node);
+                call.qualified_name = call.name;
+            } else if (strcmp(func_type, "attribute") == 0) {
+                // obj.method() - get the full attribute chain
+                call.name = node_text(func_node);
+                call.qualified_name = call.name;
+            }
 
-                if (!call.name.empty()) {
-                    calls.push_back(call);
-                }
+            if (!call.name.empty()) {
+                calls.push_back(call);
             }
         }
-    });
+    }
 
     return calls;
 }
@@ -353,62 +517,62 @@ std::vector<FunctionDef> LanguageParser::extract_functions_c() const {
     if (!tree_)
         return functions;
 
-    visit_nodes(root(), [&](TSNode node) {
-        const char *type = ts_node_type(node);
-
-        if (strcmp(type, "function_definition") == 0) {
-            FunctionDef func;
-
-            // Get declarator which contains function name and parameters
-            TSNode declarator = ts_node_child_by_field_name(node, "declarator", 10);
-            if (!ts_node_is_null(declarator)) {
-                // Navigate to function_declarator
-                const char *decl_type = ts_node_type(declarator);
-                TSNode func_decl = declarator;
+    ts_query_cursor_exec(cursor_, queries_->functions, root());
+    TSQueryMatch match;
+    uint32_t capture_index;
+    while (ts_query_cursor_next_capture(cursor_, &match, &capture_index)) {
+        TSNode node = match.captures[capture_index].node;
+        FunctionDef func;
+
+        // Get declarator which contains function name and parameters
+        TSNode declarator = ts_node_child_by_field_name(node, "declarator", 10);
+        if (!ts_node_is_null(declarator)) {
+            // Navigate to function_declarator
+            const char *decl_type = ts_node_type(declarator);
+            TSNode func_decl = declarator;
+
+            // Handle pointer declarators
+            while (strcmp(decl_type, "pointer_declarator") == 0) {
+                func_decl = ts_node_child_by_field_name(func_decl, "declarator", 10);
+                if (ts_node_is_null(func_decl))
+                    break;
+                decl_type = ts_node_type(func_decl);
+            }
 
-                // Handle pointer declarators
-                while (strcmp(decl_type, "pointer_declarator") == 0) {
-                    func_decl = ts_node_child_by_field_name(func_decl, "declarator", 10);
-                    if (ts_node_is_null(func_decl))
-                        break;
-                    decl_type = ts_node_type(func_decl);
+            if (strcmp(decl_type, "function_declarator") == 0) {
+                // Get function name
+                TSNode name_decl = ts_node_child_by_field_name(func_decl, "declarator", 10);
+                if (!ts_node_is_null(name_decl)) {
+                    func.name = node_text(name_decl);
                 }
 
-                if (strcmp(decl_type, "function_declarator") == 0) {
-                    // Get function name
-                    TSNode name_decl = ts_node_child_by_field_name(func_decl, "declarator", 10);
-                    if (!ts_node_is_null(name_decl)) {
-                        func.name = node_text(name_decl);
-                    }
-
-                    // Get parameters
-                    TSNode params = ts_node_child_by_field_name(func_decl, "parameters", 10);
-                    if (!ts_node_is_null(params)) {
-                        uint32_t param_count = ts_node_named_child_count(params);
-                        for (uint32_t i = 0; i < param_count; ++i) {
-                            TSNode param = ts_node_named_child(params, i);
-                            const char *param_type_str = ts_node_type(param);
-
-                            if (strcmp(param_type_str, "parameter_declaration") == 0) {
-                                TSNode type_node = ts_node_child_by_field_name(param, "type", 4);
-                                if (!ts_node_is_null(type_node)) {
-                                    func.param_types.push_back(node_text(type_node));
-                                }
+                // Get parameters
+                TSNode params = ts_node_child_by_field_name(func_decl, "parameters", 10);
+                if (!ts_node_is_null(params)) {
+                    uint32_t param_count = ts_node_named_child_count(params);
+                    for (uint32_t i = 0; i < param_count; ++i) {
+                        TSNode param = ts_node_named_child(params, i);
+                        const char *param_type_str = ts_node_type(param);
+
+                        if (strcmp(param_type_str, "parameter_declaration") == 0) {
+                            TSNode type_node = ts_node_child_by_field_name(param, "type", 4);
+                            if (!ts_node_is_null(type_node)) {
+                                func.param_types.push_back(node_text(type_node));
                             }
                         }
                     }
                 }
             }
+        }
 
-            if (!func.name.empty()) {
-                func.qualified_name = build_qualified_name(func.name, func.param_types);
-                func.start_line = ts_node_start_point(node).row + 1;
-                func.end_line = ts_node_end_point(node).row + 1;
-                func.node = node;
-                functions.push_back(func);
-            }
+        if (!func.name.empty()) {
+            func.qualified_name = build_qualified_name(func.name, func.param_types);
+            func.start_line = ts_node_start_point(node).row + 1;
+            func.end_line = ts_node_end_point(node).row + 1;
+            func.node = node;
+            functions.push_back(func);
         }
-    });
+    }
 
     return functions;
 }
@@ -416,40 +580,40 @@ std::vector<FunctionDef> LanguageParser::extract_functions_c() const {
 std::vector<FunctionCall> LanguageParser::extract_calls_c(const FunctionDef &func) const {
     std::vector<FunctionCall> calls;
 
-    visit_nodes(func.node, [&](TSNode node) {
-        const char *type = ts_node_type(node);
-
-        if (strcmp(type, "call_expression") == 0) {
-            FunctionCall call;
-            call.line = ts_node_start_point(node).row + 1;
-            call.node = node;
-
-            TSNode func_node = ts_node_child_by_field_name(node, "function", 8);
-            if (!ts_node_is_null(func_node)) {
-                const char *func_type = ts_node_type(func_node);
-
-                if (strcmp(func_type, "identifier") == 0) {
-                    call.name = node_text(func_node);
-                    call.qualified_name = call.name;
-                } else if (strcmp(func_type, "field_expression") == 0) {
-                    // struct->func or struct.func
-                    TSNode field = ts_node_child_by_field_name(func_node, "field", 5);
-                    if (!ts_node_is_null(field)) {
-                        call.name = node_text(field);
-                        call.qualified_name = call.name;
-                    }
-                } else if (strcmp(func_type, "parenthesized_expression") == 0) {
-                    // Function pointer call (*func_ptr)()
-                    call.name = node_text(func_node);
+    ts_query_cursor_exec(cursor_, queries_->calls, func.node);
+    TSQueryMatch match;
+    uint32_t capture_index;
+    while (ts_query_cursor_next_capture(cursor_, &match, &capture_index)) {
+        TSNode node = match.captures[capture_index].node;
+        FunctionCall call;
+        call.line = ts_node_start_point(node).row + 1;
+        call.node = node;
+
+        TSNode func_node = ts_node_child_by_field_name(node, "function", 8);
+        if (!ts_node_is_null(func_node)) {
+            const char *func_type = ts_node_type(func_node);
+
+            if (strcmp(func_type, "identifier") == 0) {
+                call.name = node_text(func_node);
+                call.qualified_name = call.name;
+            } else if (strcmp(func_type, "field_expression") == 0) {
+                // struct->func or struct.func
+                TSNode field = ts_node_child_by_field_name(func_node, "field", 5);
+                if (!ts_node_is_null(field)) {
+                    call.name = node_text(field);
                     call.qualified_name = call.name;
                 }
+            } else if (strcmp(func_type, "parenthesized_expression") == 0) {
+                // Function pointer call (*func_ptr)()
+                call.name = node_text(func_node);
+                call.qualified_name = call.name;
+            }
 
-                if (!call.name.empty()) {
-                    calls.push_back(call);
-                }
+            if (!call.name.empty()) {
+                calls.push_back(call);
             }
         }
-    });
+    }
 
     return calls;
 }
@@ -463,14 +627,18 @@ std::vector<FunctionDef> LanguageParser::extract_functions_cpp() const {
 
     // Track namespace and class context
     struct Context {
-        std::string name;
+        std::string_view name;
         bool is_class;
         uint32_t end_byte;
     };
     std::vector<Context> context_stack;
 
-    visit_nodes(root(), [&](TSNode node) {
-        const char *type = ts_node_type(node);
+    ts_query_cursor_exec(cursor_, queries_->functions, root());
+    TSQueryMatch match;
+    uint32_t capture_index;
+    while (ts_query_cursor_next_capture(cursor_, &match, &capture_index)) {
+        const TSQueryCapture &capture = match.captures[capture_index];
+        TSNode node = capture.node;
         uint32_t start_byte = ts_node_start_byte(node);
 
         // Pop contexts that we've exited
@@ -478,7 +646,7 @@ std::vector<FunctionDef> LanguageParser::extract_functions_cpp() const {
             context_stack.pop_back();
         }
 
-        if (strcmp(type, "namespace_definition") == 0) {
+        if (capture.index == queries_->namespace_capture) {
             TSNode name_node = ts_node_child_by_field_name(node, "name", 4);
             if (!ts_node_is_null(name_node)) {
                 Context ctx;
@@ -487,7 +655,7 @@ std::vector<FunctionDef> LanguageParser::extract_functions_cpp() const {
                 ctx.end_byte = ts_node_end_byte(node);
                 context_stack.push_back(ctx);
             }
-        } else if (strcmp(type, "class_specifier") == 0 || strcmp(type, "struct_specifier") == 0) {
+        } else if (capture.index == queries_->class_capture) {
             TSNode name_node = ts_node_child_by_field_name(node, "name", 4);
             if (!ts_node_is_null(name_node)) {
                 Context ctx;
@@ -496,7 +664,7 @@ std::vector<FunctionDef> LanguageParser::extract_functions_cpp() const {
                 ctx.end_byte = ts_node_end_byte(node);
                 context_stack.push_back(ctx);
             }
-        } else if (strcmp(type, "function_definition") == 0) {
+        } else {
             FunctionDef func;
 
             // Get declarator
@@ -559,7 +727,8 @@ std::vector<FunctionDef> LanguageParser::extract_functions_cpp() const {
                 // Build qualified name from context stack
                 std::string prefix;
                 for (const auto &ctx : context_stack) {
-                    prefix += ctx.name + "::";
+                    prefix += ctx.name;
+                    prefix += "::";
                     if (ctx.is_class) {
                         func.containing_class = ctx.name;
                     }
@@ -568,19 +737,19 @@ std::vector<FunctionDef> LanguageParser::extract_functions_cpp() const {
                 // If name already contains ::, don't add prefix
                 if (func.name.find("::") == std::string::npos) {
                     func.qualified_name =
-                        prefix + build_qualified_name(func.name, func.param_types);
+                        arena_.concat(prefix, build_qualified_name(func.name, func.param_types));
                 } else {
                     func.qualified_name = build_qualified_name(func.name, func.param_types);
                 }
 
-                func.namespace_path = prefix;
+                func.namespace_path = arena_.store(prefix);
                 func.start_line = ts_node_start_point(node).row + 1;
                 func.end_line = ts_node_end_point(node).row + 1;
                 func.node = node;
                 functions.push_back(func);
             }
         }
-    });
+    }
 
     return functions;
 }
@@ -588,10 +757,14 @@ std::vector<FunctionDef> LanguageParser::extract_functions_cpp() const {
 std::vector<FunctionCall> LanguageParser::extract_calls_cpp(const FunctionDef &func) const {
     std::vector<FunctionCall> calls;
 
-    visit_nodes(func.node, [&](TSNode node) {
-        const char *type = ts_node_type(node);
+    ts_query_cursor_exec(cursor_, queries_->calls, func.node);
+    TSQueryMatch match;
+    uint32_t capture_index;
+    while (ts_query_cursor_next_capture(cursor_, &match, &capture_index)) {
+        const TSQueryCapture &capture = match.captures[capture_index];
+        TSNode node = capture.node;
 
-        if (strcmp(type, "call_expression") == 0) {
+        if (capture.index == queries_->call_capture) {
             FunctionCall call;
             call.line = ts_node_start_point(node).row + 1;
             call.node = node;
@@ -631,7 +804,7 @@ std::vector<FunctionCall> LanguageParser::extract_calls_cpp(const FunctionDef &f
             }
         }
         // Constructor calls (new expressions)
-        else if (strcmp(type, "new_expression") == 0) {
+        else {
             FunctionCall call;
             call.line = ts_node_start_point(node).row + 1;
             call.node = node;
@@ -643,7 +816,7 @@ std::vector<FunctionCall> LanguageParser::extract_calls_cpp(const FunctionDef &f
                 calls.push_back(call);
             }
         }
-    });
+    }
 
     return calls;
 }
@@ -653,11 +826,15 @@ std::vector<FunctionCall> LanguageParser::extract_calls_cpp(const FunctionDef &f
 std::vector<VariableDef> LanguageParser::extract_variables_python(const FunctionDef &func) const {
     std::vector<VariableDef> variables;
 
-    visit_nodes(func.node, [&](TSNode node) {
-        const char *type = ts_node_type(node);
+    ts_query_cursor_exec(cursor_, queries_->variables, func.node);
+    TSQueryMatch match;
+    uint32_t capture_index;
+    while (ts_query_cursor_next_capture(cursor_, &match, &capture_index)) {
+        const TSQueryCapture &capture = match.captures[capture_index];
+        TSNode node = capture.node;
 
         // assignment: left = right
-        if (strcmp(type, "assignment") == 0) {
+        if (capture.index == queries_->assign_capture) {
             TSNode left = ts_node_child_by_field_name(node, "left", 4);
             TSNode right = ts_node_child_by_field_name(node, "right", 5);
 
@@ -683,7 +860,7 @@ std::vector<VariableDef> LanguageParser::extract_variables_python(const Function
                 if (strcmp(left_type, "identifier") == 0) {
                     VariableDef var;
                     var.name = node_text(left);
-                    var.qualified_name = func.qualified_name + "." + var.name;
+                    var.qualified_name = arena_.concat(func.qualified_name, ".", var.name);
                     var.containing_func = func.qualified_name;
                     var.line = ts_node_start_point(node).row + 1;
                     var.node = node;
@@ -695,7 +872,7 @@ std::vector<VariableDef> LanguageParser::extract_variables_python(const Function
                     VariableDef var;
                     // Get the full attribute chain (e.g., "self.field" or "obj.attr.subattr")
                     var.name = node_text(left);
-                    var.qualified_name = func.qualified_name + "." + var.name;
+                    var.qualified_name = arena_.concat(func.qualified_name, ".", var.name);
                     var.containing_func = func.qualified_name;
                     var.line = ts_node_start_point(node).row + 1;
                     var.node = node;
@@ -706,7 +883,7 @@ std::vector<VariableDef> LanguageParser::extract_variables_python(const Function
                 else if (strcmp(left_type, "subscript") == 0) {
                     VariableDef var;
                     var.name = node_text(left);
-                    var.qualified_name = func.qualified_name + "." + var.name;
+                    var.qualified_name = arena_.concat(func.qualified_name, ".", var.name);
                     var.containing_func = func.qualified_name;
                     var.line = ts_node_start_point(node).row + 1;
                     var.node = node;
@@ -722,7 +899,7 @@ std::vector<VariableDef> LanguageParser::extract_variables_python(const Function
                         if (strcmp(ts_node_type(child), "identifier") == 0) {
                             VariableDef var;
                             var.name = node_text(child);
-                            var.qualified_name = func.qualified_name + "." + var.name;
+                            var.qualified_name = arena_.concat(func.qualified_name, ".", var.name);
                             var.containing_func = func.qualified_name;
                             var.line = ts_node_start_point(node).row + 1;
                             var.node = node;
@@ -735,14 +912,14 @@ std::vector<VariableDef> LanguageParser::extract_variables_python(const Function
             }
         }
         // augmented_assignment: x += ..., x -= ..., etc.
-        else if (strcmp(type, "augmented_assignment") == 0) {
+        else {
             TSNode left = ts_node_child_by_field_name(node, "left", 4);
             TSNode right = ts_node_child_by_field_name(node, "right", 5);
 
             if (!ts_node_is_null(left) && strcmp(ts_node_type(left), "identifier") == 0) {
                 VariableDef var;
                 var.name = node_text(left);
-                var.qualified_name = func.qualified_name + "." + var.name;
+                var.qualified_name = arena_.concat(func.qualified_name, ".", var.name);
                 var.containing_func = func.qualified_name;
                 var.line = ts_node_start_point(node).row + 1;
                 var.node = node;
@@ -752,7 +929,7 @@ std::vector<VariableDef> LanguageParser::extract_variables_python(const Function
                 variables.push_back(var);
             }
         }
-    });
+    }
 
     return variables;
 }
@@ -762,11 +939,15 @@ std::vector<VariableDef> LanguageParser::extract_variables_python(const Function
 std::vector<VariableDef> LanguageParser::extract_variables_c(const FunctionDef &func) const {
     std::vector<VariableDef> variables;
 
-    visit_nodes(func.node, [&](TSNode node) {
-        const char *type = ts_node_type(node);
+    ts_query_cursor_exec(cursor_, queries_->variables, func.node);
+    TSQueryMatch match;
+    uint32_t capture_index;
+    while (ts_query_cursor_next_capture(cursor_, &match, &capture_index)) {
+        const TSQueryCapture &capture = match.captures[capture_index];
+        TSNode node = capture.node;
 
         // declaration: int x = value;
-        if (strcmp(type, "declaration") == 0) {
+        if (capture.index == queries_->decl_capture) {
             // Find declarators in the declaration
             uint32_t count = ts_node_child_count(node);
             for (uint32_t i = 0; i < count; ++i) {
@@ -794,7 +975,7 @@ std::vector<VariableDef> LanguageParser::extract_variables_c(const FunctionDef &
                         if (strcmp(ts_node_type(name_node), "identifier") == 0) {
                             VariableDef var;
                             var.name = node_text(name_node);
-                            var.qualified_name = func.qualified_name + "::" + var.name;
+                            var.qualified_name = arena_.concat(func.qualified_name, "::", var.name);
                             var.containing_func = func.qualified_name;
                             var.line = ts_node_start_point(node).row + 1;
                             var.node = node;
@@ -817,7 +998,7 @@ std::vector<VariableDef> LanguageParser::extract_variables_c(const FunctionDef &
             }
         }
         // assignment_expression: x = value, obj.field = value, ptr->field = value
-        else if (strcmp(type, "assignment_expression") == 0) {
+        else {
             TSNode left = ts_node_child_by_field_name(node, "left", 4);
             TSNode right = ts_node_child_by_field_name(node, "right", 5);
 
@@ -831,25 +1012,25 @@ std::vector<VariableDef> LanguageParser::extract_variables_c(const FunctionDef &
                 // Simple identifier: x = value
                 if (strcmp(left_type, "identifier") == 0) {
                     var.name = node_text(left);
-                    var.qualified_name = func.qualified_name + "::" + var.name;
+                    var.qualified_name = arena_.concat(func.qualified_name, "::", var.name);
                 }
                 // Member access: obj.field = value
                 else if (strcmp(left_type, "field_expression") == 0) {
                     var.name = node_text(left);
-                    var.qualified_name = func.qualified_name + "::" + var.name;
+                    var.qualified_name = arena_.concat(func.qualified_name, "::", var.name);
                 }
                 // Pointer member: ptr->field = value
                 else if (strcmp(left_type, "pointer_expression") == 0) {
                     var.name = node_text(left);
-                    var.qualified_name = func.qualified_name + "::" + var.name;
+                    var.qualified_name = arena_.concat(func.qualified_name, "::", var.name);
                 }
                 // Array subscript: arr[i] = value
                 else if (strcmp(left_type, "subscript_expression") == 0) {
                     var.name = node_text(left);
-                    var.qualified_name = func.qualified_name + "::" + var.name;
+                    var.qualified_name = arena_.concat(func.qualified_name, "::", var.name);
                 } else {
                     // Skip other types
-                    return;
+                    continue;
                 }
 
                 if (!ts_node_is_null(right)) {
@@ -866,7 +1047,7 @@ std::vector<VariableDef> LanguageParser::extract_variables_c(const FunctionDef &
                 variables.push_back(var);
             }
         }
-    });
+    }
 
     return variables;
 }
@@ -876,11 +1057,15 @@ std::vector<VariableDef> LanguageParser::extract_variables_c(const FunctionDef &
 std::vector<VariableDef> LanguageParser::extract_variables_cpp(const FunctionDef &func) const {
     std::vector<VariableDef> variables;
 
-    visit_nodes(func.node, [&](TSNode node) {
-        const char *type = ts_node_type(node);
+    ts_query_cursor_exec(cursor_, queries_->variables, func.node);
+    TSQueryMatch match;
+    uint32_t capture_index;
+    while (ts_query_cursor_next_capture(cursor_, &match, &capture_index)) {
+        const TSQueryCapture &capture = match.captures[capture_index];
+        TSNode node = capture.node;
 
         // declaration: auto x = value; int x = value;
-        if (strcmp(type, "declaration") == 0) {
+        if (capture.index == queries_->decl_capture) {
             uint32_t count = ts_node_child_count(node);
             for (uint32_t i = 0; i < count; ++i) {
                 TSNode child = ts_node_child(node, i);
@@ -912,7 +1097,7 @@ std::vector<VariableDef> LanguageParser::extract_variables_cpp(const FunctionDef
                         if (strcmp(ts_node_type(name_node), "identifier") == 0) {
                             VariableDef var;
                             var.name = node_text(name_node);
-                            var.qualified_name = func.qualified_name + "::" + var.name;
+                            var.qualified_name = arena_.concat(func.qualified_name, "::", var.name);
                             var.containing_func = func.qualified_name;
                             var.line = ts_node_start_point(node).row + 1;
                             var.node = node;
@@ -940,7 +1125,7 @@ std::vector<VariableDef> LanguageParser::extract_variables_cpp(const FunctionDef
             }
         }
         // assignment_expression: x = value, obj.field = value, ptr->field = value
-        else if (strcmp(type, "assignment_expression") == 0) {
+        else {
             TSNode left = ts_node_child_by_field_name(node, "left", 4);
             TSNode right = ts_node_child_by_field_name(node, "right", 5);
 
@@ -954,25 +1139,25 @@ std::vector<VariableDef> LanguageParser::extract_variables_cpp(const FunctionDef
                 // Simple identifier: x = value
                 if (strcmp(left_type, "identifier") == 0) {
                     var.name = node_text(left);
-                    var.qualified_name = func.qualified_name + "::" + var.name;
+                    var.qualified_name = arena_.concat(func.qualified_name, "::", var.name);
                 }
                 // Member access: obj.field = value
                 else if (strcmp(left_type, "field_expression") == 0) {
                     var.name = node_text(left);
-                    var.qualified_name = func.qualified_name + "::" + var.name;
+                    var.qualified_name = arena_.concat(func.qualified_name, "::", var.name);
                 }
                 // Pointer member: ptr->field = value
                 else if (strcmp(left_type, "pointer_expression") == 0) {
                     var.name = node_text(left);
-                    var.qualified_name = func.qualified_name + "::" + var.name;
+                    var.qualified_name = arena_.concat(func.qualified_name, "::", var.name);
                 }
                 // Array subscript: arr[i] = value
                 else if (strcmp(left_type, "subscript_expression") == 0) {
                     var.name = node_text(left);
-                    var.qualified_name = func.qualified_name + "::" + var.name;
+                    var.qualified_name = arena_.concat(func.qualified_name, "::", var.name);
                 } else {
                     // Skip other types
-                    return;
+                    continue;
                 }
 
                 if (!ts_node_is_null(right)) {
@@ -989,7 +1174,7 @@ std::vector<VariableDef> LanguageParser::extract_variables_cpp(const FunctionDef
                 variables.push_back(var);
             }
         }
-    });
+    }
 
     return variables;
 }
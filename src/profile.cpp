@@ -0,0 +1,92 @@
+// Copyright 2025 Siddhant Biradar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pioneer/profile.hpp"
+#include <atomic>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <nlohmann/json.hpp>
+
+namespace pioneer {
+
+namespace prof {
+
+namespace {
+
+std::atomic<bool> g_enabled{false};
+
+struct TimerEntry {
+    uint64_t total_ns = 0;
+    uint64_t calls = 0;
+};
+
+// Ordered maps so the report is stable across runs; entries are touched at
+// phase granularity, so lock contention is not a concern.
+std::mutex g_mutex;
+std::map<std::string, TimerEntry> g_timers;
+std::map<std::string, uint64_t> g_counters;
+
+} // namespace
+
+bool enabled() { return g_enabled.load(std::memory_order_relaxed); }
+
+void set_enabled(bool on) { g_enabled.store(on, std::memory_order_relaxed); }
+
+void add_time(const char *section, uint64_t nanos) {
+    if (!enabled())
+        return;
+    std::lock_guard<std::mutex> lock(g_mutex);
+    auto &entry = g_timers[section];
+    entry.total_ns += nanos;
+    entry.calls++;
+}
+
+void add_count(const char *counter, uint64_t n) {
+    if (!enabled())
+        return;
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_counters[counter] += n;
+}
+
+void report(std::ostream &out, bool as_json) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+
+    if (as_json) {
+        nlohmann::json j;
+        for (const auto &[name, entry] : g_timers) {
+            j["timers"][name] = {{"total_ms", entry.total_ns / 1e6}, {"calls", entry.calls}};
+        }
+        for (const auto &[name, value] : g_counters) {
+            j["counters"][name] = value;
+        }
+        out << j.dump() << std::endl;
+        return;
+    }
+
+    out << "\n=== profile ===" << std::endl;
+    for (const auto &[name, entry] : g_timers) {
+        out << "  " << std::left << std::setw(28) << name << std::right << std::fixed
+            << std::setprecision(3) << std::setw(12) << (entry.total_ns / 1e6) << " ms"
+            << std::setw(10) << entry.calls << " calls" << std::endl;
+    }
+    for (const auto &[name, value] : g_counters) {
+        out << "  " << std::left << std::setw(28) << name << std::right << std::setw(12) << value
+            << std::endl;
+    }
+}
+
+} // namespace prof
+
+} // namespace pioneer
@@ -13,15 +13,163 @@
 // limitations under the License.
 
 #include "pioneer/query.hpp"
+#include "pioneer/profile.hpp"
+#include "pioneer/simd_match.hpp"
 #include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <queue>
 #include <stack>
+#include <thread>
 #include <unordered_set>
 
 namespace pioneer {
 
+namespace {
+
+// Smallest frontier worth fanning out across threads; below this the
+// per-level thread handoff costs more than the expansion itself
+constexpr size_t PARALLEL_FRONTIER_MIN = 2048;
+
+// Level-synchronous BFS closure over a packed adjacency. Visited state is a
+// shared atomic bitmap (fetch_or per word), so threads discover nodes
+// without locks; each frontier level is partitioned across the pool and the
+// per-thread discoveries are concatenated into the next level. Small levels
+// are expanded inline - most queries never leave the serial path, but wide
+// closures over big graphs scale with cores.
+std::vector<uint8_t> bfs_closure(const CsrAdjacency &adj, uint32_t source, uint32_t node_count) {
+    prof::ScopedTimer timer("query.bfs_closure");
+    std::vector<std::atomic<uint64_t>> visited((node_count + 63) / 64);
+    auto try_visit = [&](uint32_t node) {
+        uint64_t bit = 1ULL << (node & 63);
+        return (visited[node >> 6].fetch_or(bit, std::memory_order_relaxed) & bit) == 0;
+    };
+
+    unsigned int num_threads = std::thread::hardware_concurrency();
+    if (num_threads == 0) {
+        num_threads = 1;
+    }
+
+    std::vector<uint32_t> frontier;
+    frontier.push_back(source);
+    try_visit(source);
+
+    std::vector<uint32_t> next;
+    while (!frontier.empty()) {
+        next.clear();
+
+        if (num_threads <= 1 || frontier.size() < PARALLEL_FRONTIER_MIN) {
+            for (uint32_t node : frontier) {
+                auto [it, end_it] = adj.neighbors(node);
+                for (; it != end_it; ++it) {
+                    if (try_visit(*it)) {
+                        next.push_back(*it);
+                    }
+                }
+            }
+        } else {
+            std::vector<std::vector<uint32_t>> partials(num_threads);
+            std::vector<std::thread> workers;
+            workers.reserve(num_threads);
+            for (unsigned int t = 0; t < num_threads; ++t) {
+                workers.emplace_back([&, t]() {
+                    size_t begin = frontier.size() * t / num_threads;
+                    size_t end = frontier.size() * (t + 1) / num_threads;
+                    std::vector<uint32_t> &local = partials[t];
+                    for (size_t i = begin; i < end; ++i) {
+                        auto [it, end_it] = adj.neighbors(frontier[i]);
+                        for (; it != end_it; ++it) {
+                            if (try_visit(*it)) {
+                                local.push_back(*it);
+                            }
+                        }
+                    }
+                });
+            }
+            for (auto &worker : workers) {
+                worker.join();
+            }
+            for (const auto &local : partials) {
+                next.insert(next.end(), local.begin(), local.end());
+            }
+        }
+
+        frontier.swap(next);
+    }
+
+    std::vector<uint8_t> closure(node_count, 0);
+    uint64_t visited_count = 0;
+    for (uint32_t node = 0; node < node_count; ++node) {
+        if (visited[node >> 6].load(std::memory_order_relaxed) & (1ULL << (node & 63))) {
+            closure[node] = 1;
+            visited_count++;
+        }
+    }
+    prof::add_count("query.closure_nodes", visited_count);
+    return closure;
+}
+
+} // namespace
+
 QueryEngine::QueryEngine(const Graph &graph) : graph_(graph) {}
 
+bool QueryEngine::skip_hub(SymbolUID uid) const {
+    return hub_limit_ != 0 && graph_.symbol_degree(uid) > hub_limit_;
+}
+
+bool QueryEngine::out_of_scope(SymbolUID uid) const {
+    return scope_enabled_ && (uid >= scope_allowed_.size() || scope_allowed_[uid] == 0);
+}
+
+bool QueryEngine::set_scope(const std::string &dir) {
+    scope_enabled_ = false;
+    scope_allowed_.clear();
+    if (dir.empty()) {
+        return true;
+    }
+
+    // Descend the trie to the requested directory, skipping the "." and
+    // empty segments the trie builder drops (so "./src/net/" and "src/net"
+    // name the same node)
+    const PathNode *node = &graph_.call_graph.path_trie();
+    size_t pos = 0;
+    while (pos < dir.size()) {
+        size_t next = dir.find_first_of("/\\", pos);
+        size_t seg_end = (next == std::string::npos) ? dir.size() : next;
+        std::string segment = dir.substr(pos, seg_end - pos);
+        pos = (next == std::string::npos) ? dir.size() : next + 1;
+        if (segment.empty() || segment == ".") {
+            continue;
+        }
+        auto it = node->subdirs.find(segment);
+        if (it == node->subdirs.end()) {
+            return false;
+        }
+        node = &it->second;
+    }
+
+    // Allow every symbol defined by a file in the subtree
+    scope_allowed_.assign(static_cast<size_t>(graph_.call_graph.next_uid) + 1, 0);
+    std::vector<const PathNode *> pending{node};
+    while (!pending.empty()) {
+        const PathNode *current = pending.back();
+        pending.pop_back();
+        for (SymbolUID file_uid : current->file_uids) {
+            for (SymbolUID sym : graph_.get_file_symbols(file_uid)) {
+                if (sym < scope_allowed_.size()) {
+                    scope_allowed_[sym] = 1;
+                }
+            }
+        }
+        for (const auto &[name, child] : current->subdirs) {
+            pending.push_back(&child);
+        }
+    }
+
+    scope_enabled_ = true;
+    return true;
+}
+
 bool QueryEngine::has_symbol(const std::string &name) const { return graph_.has_symbol(name); }
 
 std::vector<std::string> QueryEngine::find_symbols(const std::vector<std::string> &patterns) const {
@@ -35,7 +183,7 @@ std::vector<std::string> QueryEngine::find_symbols(const std::vector<std::string
     for (size_t i = 1; i < patterns.size() && !matches.empty(); ++i) {
         std::vector<std::string> filtered;
         for (const auto &sym : matches) {
-            if (sym.find(patterns[i]) != std::string::npos) {
+            if (simd::contains(sym, patterns[i])) {
                 filtered.push_back(sym);
             }
         }
@@ -48,8 +196,28 @@ std::vector<std::string> QueryEngine::find_symbols(const std::vector<std::string
 std::vector<std::string> QueryEngine::find_symbols(const std::string &pattern) const {
     std::vector<std::string> matches;
 
+    // The trigram index narrows the search to candidate symbols; each
+    // candidate is still verified since trigram containment over-approximates
+    // substring containment. Short patterns fall back to the full scan.
+    std::vector<SymbolUID> candidates;
+    if (graph_.call_graph.symbol_trigrams().candidates(pattern, candidates)) {
+        for (SymbolUID uid : candidates) {
+            if (out_of_scope(uid)) {
+                continue;
+            }
+            const std::string &symbol = graph_.get_symbol(uid);
+            if (simd::contains(symbol, pattern)) {
+                matches.push_back(symbol);
+            }
+        }
+        return matches;
+    }
+
     for (const auto &[symbol, uid] : graph_.get_symbol_map()) {
-        if (symbol.find(pattern) != std::string::npos) {
+        if (out_of_scope(uid)) {
+            continue;
+        }
+        if (simd::contains(symbol, pattern)) {
             matches.push_back(symbol);
         }
     }
@@ -100,8 +268,61 @@ void QueryEngine::print_path(const std::vector<std::string> &path, const Graph &
     }
 }
 
+// UID-level variant: symbol names and file paths come straight from the
+// graph's pools, so printing allocates nothing per path
+void QueryEngine::print_path(std::span<const SymbolUID> path, const Graph &graph,
+                             bool show_paths) {
+    if (!show_paths) {
+        for (size_t i = 0; i < path.size(); ++i) {
+            std::cout << graph.get_symbol(path[i]);
+            if (i < path.size() - 1) {
+                std::cout << " -> ";
+            }
+        }
+        std::cout << std::endl;
+        return;
+    }
+
+    // Print each symbol on its own line with file path
+    for (size_t i = 0; i < path.size(); ++i) {
+        std::cout << "  ";
+        if (i < path.size() - 1) {
+            std::cout << "└─> ";
+        } else {
+            std::cout << "    ";
+        }
+
+        std::cout << graph.get_symbol(path[i]);
+
+        SymbolUID file_uid = graph.get_symbol_file_uid(path[i]);
+        if (file_uid != INVALID_UID) {
+            std::string filepath = graph.get_file_path(file_uid);
+            if (!filepath.empty()) {
+                std::cout << " [" << filepath << "]";
+            }
+        }
+        std::cout << std::endl;
+    }
+}
+
+UidPathCallback QueryEngine::stringify(PathCallback callback) const {
+    return [this, callback = std::move(callback)](std::span<const SymbolUID> path) {
+        std::vector<std::string> path_str;
+        path_str.reserve(path.size());
+        for (SymbolUID uid : path) {
+            path_str.push_back(graph_.get_symbol(uid));
+        }
+        return callback(path_str);
+    };
+}
+
 void QueryEngine::find_paths(const std::string &start, const std::string &end,
                              PathCallback callback) {
+    find_paths(start, end, stringify(std::move(callback)));
+}
+
+void QueryEngine::find_paths(const std::string &start, const std::string &end,
+                             UidPathCallback callback) {
     if (start == "START") {
         backtrace(end, callback);
         return;
@@ -136,6 +357,10 @@ void QueryEngine::find_paths(const std::string &start, const std::string &end,
 }
 
 void QueryEngine::backtrace(const std::string &symbol, PathCallback callback) {
+    backtrace(symbol, stringify(std::move(callback)));
+}
+
+void QueryEngine::backtrace(const std::string &symbol, UidPathCallback callback) {
     SymbolUID target_uid = graph_.get_uid(symbol);
 
     if (target_uid == INVALID_UID) {
@@ -147,6 +372,10 @@ void QueryEngine::backtrace(const std::string &symbol, PathCallback callback) {
 }
 
 void QueryEngine::forward_trace(const std::string &symbol, PathCallback callback) {
+    forward_trace(symbol, stringify(std::move(callback)));
+}
+
+void QueryEngine::forward_trace(const std::string &symbol, UidPathCallback callback) {
     SymbolUID start_uid = graph_.get_uid(symbol);
 
     if (start_uid == INVALID_UID) {
@@ -158,13 +387,17 @@ void QueryEngine::forward_trace(const std::string &symbol, PathCallback callback
     dfs_forward(start_uid, end_uid, callback);
 }
 
-// Optimized DFS using iterators instead of copying callee vectors
-void QueryEngine::dfs_forward(SymbolUID start, SymbolUID end, PathCallback &callback) {
-    // State stores iterators into the graph's callee sets - NO COPYING
+// Optimized DFS over the packed CSR adjacency - each neighbor list is a
+// contiguous slice, so advancing is a pointer increment with no hashing
+void QueryEngine::dfs_forward(SymbolUID start, SymbolUID end, UidPathCallback &callback) {
+    prof::ScopedTimer timer("query.dfs_forward");
+    prof::ScopedCounter expanded("query.nodes_expanded");
+
+    // State stores pointers into the CSR neighbor array - NO COPYING
     struct State {
         SymbolUID node;
-        std::unordered_set<SymbolUID>::const_iterator current_it;
-        std::unordered_set<SymbolUID>::const_iterator end_it;
+        const SymbolUID *current_it;
+        const SymbolUID *end_it;
     };
 
     std::vector<State> stack; // Use vector for better cache locality
@@ -177,8 +410,8 @@ void QueryEngine::dfs_forward(SymbolUID start, SymbolUID end, PathCallback &call
     in_path.reserve(256);
 
     // Initialize with start node
-    const auto &start_callees = graph_.get_callees(start);
-    stack.push_back({start, start_callees.begin(), start_callees.end()});
+    auto [start_begin, start_end] = graph_.csr_callees(start);
+    stack.push_back({start, start_begin, start_end});
     current_path.push_back(start);
     in_path.insert(start);
 
@@ -187,14 +420,8 @@ void QueryEngine::dfs_forward(SymbolUID start, SymbolUID end, PathCallback &call
 
         // Check if we've reached the target
         if (state.node == end) {
-            // Convert path to strings and invoke callback (stream immediately)
-            std::vector<std::string> path_str;
-            path_str.reserve(current_path.size());
-            for (SymbolUID uid : current_path) {
-                path_str.push_back(graph_.get_symbol(uid));
-            }
-
-            if (!callback(path_str)) {
+            // Stream the path immediately; no per-path materialization
+            if (!callback(current_path)) {
                 return; // Callback requested stop
             }
 
@@ -216,11 +443,18 @@ void QueryEngine::dfs_forward(SymbolUID start, SymbolUID end, PathCallback &call
                 continue;
             }
 
-            // Push new state with iterators into callee's adjacency set
-            const auto &next_callees = graph_.get_callees(callee);
-            stack.push_back({callee, next_callees.begin(), next_callees.end()});
+            // Hub (--exclude-hubs) and scope (--scope) pruning; the target
+            // itself is exempt
+            if (callee != end && (skip_hub(callee) || out_of_scope(callee))) {
+                continue;
+            }
+
+            // Push new state with pointers into the callee's CSR slice
+            auto [next_begin, next_end] = graph_.csr_callees(callee);
+            stack.push_back({callee, next_begin, next_end});
             current_path.push_back(callee);
             in_path.insert(callee);
+            expanded += 1;
             found_next = true;
             break;
         }
@@ -233,13 +467,16 @@ void QueryEngine::dfs_forward(SymbolUID start, SymbolUID end, PathCallback &call
     }
 }
 
-// Optimized backward DFS using iterators instead of copying caller vectors
-void QueryEngine::dfs_backward(SymbolUID start, SymbolUID end, PathCallback &callback) {
-    // State stores iterators into the graph's caller sets - NO COPYING
+// Optimized backward DFS over the packed CSR reverse adjacency
+void QueryEngine::dfs_backward(SymbolUID start, SymbolUID end, UidPathCallback &callback) {
+    prof::ScopedTimer timer("query.dfs_backward");
+    prof::ScopedCounter expanded("query.nodes_expanded");
+
+    // State stores pointers into the CSR neighbor array - NO COPYING
     struct State {
         SymbolUID node;
-        std::unordered_set<SymbolUID>::const_iterator current_it;
-        std::unordered_set<SymbolUID>::const_iterator end_it;
+        const SymbolUID *current_it;
+        const SymbolUID *end_it;
     };
 
     std::vector<State> stack;
@@ -251,9 +488,13 @@ void QueryEngine::dfs_backward(SymbolUID start, SymbolUID end, PathCallback &cal
     std::unordered_set<SymbolUID> in_path;
     in_path.reserve(256);
 
+    // Reused emission buffer (paths are reported caller -> callee)
+    std::vector<SymbolUID> emit_buf;
+    emit_buf.reserve(256);
+
     // Initialize with start node
-    const auto &start_callers = graph_.get_callers(start);
-    stack.push_back({start, start_callers.begin(), start_callers.end()});
+    auto [start_begin, start_end] = graph_.csr_callers(start);
+    stack.push_back({start, start_begin, start_end});
     current_path.push_back(start);
     in_path.insert(start);
 
@@ -261,19 +502,13 @@ void QueryEngine::dfs_backward(SymbolUID start, SymbolUID end, PathCallback &cal
         State &state = stack.back();
 
         // Check if we've reached a root (no more callers) or specific end
-        const auto &callers = graph_.get_callers(state.node);
-        bool is_root = callers.empty();
+        bool is_root = graph_.call_graph.csr_reverse_call.empty_row(state.node);
         bool is_end = (end != INVALID_UID && state.node == end);
 
         if (is_root || is_end) {
-            // Convert path to strings (reverse to show caller -> callee) and stream immediately
-            std::vector<std::string> path_str;
-            path_str.reserve(current_path.size());
-            for (auto it = current_path.rbegin(); it != current_path.rend(); ++it) {
-                path_str.push_back(graph_.get_symbol(*it));
-            }
-
-            if (!callback(path_str)) {
+            // Reverse to show caller -> callee and stream immediately
+            emit_buf.assign(current_path.rbegin(), current_path.rend());
+            if (!callback(emit_buf)) {
                 return; // Callback requested stop
             }
 
@@ -295,11 +530,18 @@ void QueryEngine::dfs_backward(SymbolUID start, SymbolUID end, PathCallback &cal
                 continue;
             }
 
-            // Push new state with iterators
-            const auto &next_callers = graph_.get_callers(caller);
-            stack.push_back({caller, next_callers.begin(), next_callers.end()});
+            // Hub (--exclude-hubs) and scope (--scope) pruning; the target
+            // itself is exempt
+            if (caller != end && (skip_hub(caller) || out_of_scope(caller))) {
+                continue;
+            }
+
+            // Push new state with pointers into the caller's CSR slice
+            auto [next_begin, next_end] = graph_.csr_callers(caller);
+            stack.push_back({caller, next_begin, next_end});
             current_path.push_back(caller);
             in_path.insert(caller);
+            expanded += 1;
             found_next = true;
             break;
         }
@@ -314,117 +556,350 @@ void QueryEngine::dfs_backward(SymbolUID start, SymbolUID end, PathCallback &cal
 
 // Bidirectional DFS: search from both start and end, meet in the middle
 // Streams paths as soon as they are found
-void QueryEngine::dfs_bidirectional(SymbolUID start, SymbolUID end, PathCallback &callback) {
-    // First, do a backward BFS from end to find all nodes reachable backward
-    // Then do forward DFS from start, pruning branches that can't reach end
+void QueryEngine::dfs_bidirectional(SymbolUID start, SymbolUID end, UidPathCallback &callback) {
+    prof::ScopedTimer timer("query.dfs_bidirectional");
+    prof::ScopedCounter expanded("query.nodes_expanded");
+
+    // Path enumeration runs on the SCC condensation of the call graph. A
+    // loopless path can enter an SCC at most once, so on acyclic regions
+    // (every SCC a single symbol) this is exactly the node-level search;
+    // mutual-recursion clusters collapse to one DAG node, and each condensed
+    // path is expanded to one representative call chain (shortest internal
+    // route through each cluster). That bounds both the exploration and the
+    // number of reported paths inside cyclic regions, where enumerating
+    // every loopless variation is intractable and rarely useful.
+    const SccCondensation &scc = graph_.call_graph.condensation();
+    uint32_t start_scc = scc.scc_of[start];
+    uint32_t end_scc = scc.scc_of[end];
+
+    // Phase 1: backward closure over the DAG from end's SCC for pruning
+    // (parallel frontier expansion when the levels are wide enough)
+    std::vector<uint8_t> can_reach_end = bfs_closure(scc.dag_reverse, end_scc, scc.count);
+
+    // Scope filtering at SCC granularity: an SCC is in scope when any of
+    // its symbols is (intra-SCC routing may then pass through out-of-scope
+    // members of the cluster, which is the useful reading of a scope that
+    // cuts through a recursion cycle)
+    std::vector<uint8_t> scc_in_scope;
+    if (scope_enabled_) {
+        scc_in_scope.assign(scc.count, 0);
+        for (SymbolUID uid = 0; uid < scope_allowed_.size(); ++uid) {
+            if (scope_allowed_[uid] && uid < scc.scc_of.size() &&
+                scc.scc_of[uid] != SccCondensation::UNASSIGNED) {
+                scc_in_scope[scc.scc_of[uid]] = 1;
+            }
+        }
+    }
 
-    // Phase 1: Build backward reachability set from end (limited BFS)
-    std::unordered_set<SymbolUID> can_reach_end;
-    std::unordered_map<SymbolUID, std::vector<SymbolUID>>
-        backward_paths; // node -> predecessors toward end
+    // If start can't reach end at all, return early
+    if (!can_reach_end[start_scc]) {
+        return; // No paths exist
+    }
 
-    {
+    // Shortest route from `from` staying inside SCC `home`, stopping at the
+    // first node accepted. Appends the nodes after `from` to out and returns
+    // the stop node; SCCs are strongly connected so this cannot fail when an
+    // accepted node exists in home.
+    auto route_within = [&](SymbolUID from, uint32_t home, auto &&accept,
+                            std::vector<SymbolUID> &out) -> SymbolUID {
+        if (accept(from)) {
+            return from;
+        }
+        std::unordered_map<SymbolUID, SymbolUID> parent;
+        parent[from] = from;
         std::vector<SymbolUID> queue;
-        queue.push_back(end);
-        can_reach_end.insert(end);
+        queue.push_back(from);
 
         size_t head = 0;
         while (head < queue.size()) {
             SymbolUID node = queue[head++];
+            auto [it, end_it] = graph_.csr_callees(node);
+            for (; it != end_it; ++it) {
+                SymbolUID next = *it;
+                if (scc.scc_of[next] != home || parent.count(next)) {
+                    continue;
+                }
+                parent[next] = node;
+                if (accept(next)) {
+                    std::vector<SymbolUID> reversed;
+                    for (SymbolUID v = next; v != from; v = parent[v]) {
+                        reversed.push_back(v);
+                    }
+                    out.insert(out.end(), reversed.rbegin(), reversed.rend());
+                    return next;
+                }
+                queue.push_back(next);
+            }
+        }
+        return INVALID_UID;
+    };
 
-            // Get callers of this node (going backward)
-            const auto &callers = graph_.get_callers(node);
-            for (SymbolUID caller : callers) {
-                if (can_reach_end.insert(caller).second) {
-                    queue.push_back(caller);
+    // Expand one condensed path into a concrete call chain and emit it
+    std::vector<SymbolUID> node_path; // Reused across emissions
+    auto emit_condensed = [&](const std::vector<uint32_t> &scc_path) -> bool {
+        node_path.clear();
+        node_path.push_back(start);
+        SymbolUID cursor = start;
+
+        for (size_t i = 0; i < scc_path.size(); ++i) {
+            uint32_t home = scc_path[i];
+            if (i + 1 == scc_path.size()) {
+                if (route_within(cursor, home, [&](SymbolUID v) { return v == end; },
+                                 node_path) == INVALID_UID) {
+                    return true; // Should not happen; skip rather than abort
+                }
+                break;
+            }
+
+            // Reach a node with an edge into the next SCC, then cross it
+            uint32_t next_scc = scc_path[i + 1];
+            auto exits_to_next = [&](SymbolUID v) {
+                auto [it, end_it] = graph_.csr_callees(v);
+                for (; it != end_it; ++it) {
+                    if (scc.scc_of[*it] == next_scc) {
+                        return true;
+                    }
+                }
+                return false;
+            };
+            SymbolUID exit_node = route_within(cursor, home, exits_to_next, node_path);
+            if (exit_node == INVALID_UID) {
+                return true;
+            }
+            auto [it, end_it] = graph_.csr_callees(exit_node);
+            for (; it != end_it; ++it) {
+                if (scc.scc_of[*it] == next_scc) {
+                    cursor = *it;
+                    break;
                 }
             }
+            node_path.push_back(cursor);
         }
-        queue.shrink_to_fit();
-    }
 
-    // If start can't reach end at all, return early
-    if (!can_reach_end.count(start)) {
-        return; // No paths exist
-    }
+        return callback(node_path);
+    };
 
-    // Phase 2: Forward DFS from start, only exploring nodes that can reach end
+    // Phase 2: forward DFS over the DAG from start's SCC. The DAG is acyclic
+    // so no per-path visited set is needed.
     struct State {
-        SymbolUID node;
-        std::unordered_set<SymbolUID>::const_iterator current_it;
-        std::unordered_set<SymbolUID>::const_iterator end_it;
+        uint32_t node;
+        const SymbolUID *current_it;
+        const SymbolUID *end_it;
     };
 
     std::vector<State> stack;
     stack.reserve(256);
 
-    std::vector<SymbolUID> current_path;
+    std::vector<uint32_t> current_path;
     current_path.reserve(256);
 
-    std::unordered_set<SymbolUID> in_path;
-    in_path.reserve(256);
-
-    const auto &start_callees = graph_.get_callees(start);
-    stack.push_back({start, start_callees.begin(), start_callees.end()});
-    current_path.push_back(start);
-    in_path.insert(start);
+    auto [start_begin, start_end] = scc.dag.neighbors(start_scc);
+    stack.push_back({start_scc, start_begin, start_end});
+    current_path.push_back(start_scc);
 
     while (!stack.empty()) {
         State &state = stack.back();
 
         // Check if we've reached the target
-        if (state.node == end) {
-            // Convert path to strings and stream immediately
-            std::vector<std::string> path_str;
-            path_str.reserve(current_path.size());
-            for (SymbolUID uid : current_path) {
-                path_str.push_back(graph_.get_symbol(uid));
-            }
-
-            if (!callback(path_str)) {
+        if (state.node == end_scc) {
+            if (!emit_condensed(current_path)) {
                 return; // Callback requested stop
             }
-
-            // Backtrack
-            in_path.erase(state.node);
             current_path.pop_back();
             stack.pop_back();
             continue;
         }
 
-        // Find next callee to explore (only if it can reach end)
+        // Find next successor to explore (only if it can reach end)
         bool found_next = false;
         while (state.current_it != state.end_it) {
-            SymbolUID callee = *state.current_it;
+            uint32_t next = *state.current_it;
             ++state.current_it;
 
-            // Skip if already in path (cycle)
-            if (in_path.count(callee)) {
+            // PRUNING: Skip if this SCC can't reach end
+            if (!can_reach_end[next]) {
                 continue;
             }
 
-            // PRUNING: Skip if this callee can't reach end
-            if (!can_reach_end.count(callee)) {
+            // Hub pruning over the condensation: the DAG row extents give
+            // each SCC's deduplicated neighbor count, which for the
+            // single-symbol SCCs hubs are in practice equals the symbol's
+            // own degree. The end SCC is exempt.
+            if (next != end_scc && hub_limit_ != 0 &&
+                scc.dag.row_size(next) + scc.dag_reverse.row_size(next) > hub_limit_) {
                 continue;
             }
 
-            // Push new state
-            const auto &next_callees = graph_.get_callees(callee);
-            stack.push_back({callee, next_callees.begin(), next_callees.end()});
-            current_path.push_back(callee);
-            in_path.insert(callee);
+            // Scope pruning (--scope); the end SCC is exempt
+            if (next != end_scc && !scc_in_scope.empty() && scc_in_scope[next] == 0) {
+                continue;
+            }
+
+            auto [next_begin, next_end] = scc.dag.neighbors(next);
+            stack.push_back({next, next_begin, next_end});
+            current_path.push_back(next);
+            expanded += 1;
             found_next = true;
             break;
         }
 
         if (!found_next) {
-            in_path.erase(state.node);
             current_path.pop_back();
             stack.pop_back();
         }
     }
 }
 
+void QueryEngine::find_shortest_paths(const std::string &start, const std::string &end, size_t k,
+                                      PathCallback callback) {
+    find_shortest_paths(start, end, k, stringify(std::move(callback)));
+}
+
+void QueryEngine::find_shortest_paths(const std::string &start, const std::string &end, size_t k,
+                                      UidPathCallback callback) {
+    if (start == "START" || end == "END") {
+        std::cerr << "Error: --shortest requires specific --start and --end symbols" << std::endl;
+        return;
+    }
+
+    SymbolUID start_uid = graph_.get_uid(start);
+    SymbolUID end_uid = graph_.get_uid(end);
+
+    if (start_uid == INVALID_UID) {
+        std::cerr << "Error: Symbol not found: " << start << std::endl;
+        return;
+    }
+
+    if (end_uid == INVALID_UID) {
+        std::cerr << "Error: Symbol not found: " << end << std::endl;
+        return;
+    }
+
+    bfs_k_shortest(start_uid, end_uid, k, callback);
+}
+
+// Shortest-first path enumeration. A backward BFS from end computes the
+// exact remaining distance for every node that can reach it; a best-first
+// search ordered by path length + remaining distance then pops complete
+// paths in non-decreasing length order (A* with a perfect heuristic), so the
+// k most useful chains come out first with memory bounded by the frontier
+// instead of the full path space.
+void QueryEngine::bfs_k_shortest(SymbolUID start, SymbolUID end, size_t k,
+                                 UidPathCallback &callback) {
+    prof::ScopedTimer timer("query.bfs_k_shortest");
+    prof::ScopedCounter expanded("query.nodes_expanded");
+
+    // Phase 1: exact distance-to-end for every node that can reach end
+    std::unordered_map<SymbolUID, uint32_t> dist_to_end;
+    {
+        std::vector<SymbolUID> queue;
+        queue.push_back(end);
+        dist_to_end[end] = 0;
+
+        size_t head = 0;
+        while (head < queue.size()) {
+            SymbolUID node = queue[head++];
+            uint32_t next_dist = dist_to_end[node] + 1;
+
+            auto [caller_it, caller_end] = graph_.csr_callers(node);
+            for (; caller_it != caller_end; ++caller_it) {
+                if (dist_to_end.emplace(*caller_it, next_dist).second) {
+                    queue.push_back(*caller_it);
+                }
+            }
+        }
+    }
+
+    auto start_dist = dist_to_end.find(start);
+    if (start_dist == dist_to_end.end()) {
+        return; // No paths exist
+    }
+
+    // Phase 2: best-first enumeration of loopless paths
+    struct PathState {
+        uint32_t estimate; // edges so far + exact remaining distance
+        std::vector<SymbolUID> path;
+    };
+    struct LongerFirst {
+        bool operator()(const PathState &a, const PathState &b) const {
+            return a.estimate > b.estimate;
+        }
+    };
+    std::priority_queue<PathState, std::vector<PathState>, LongerFirst> frontier;
+    frontier.push({start_dist->second, {start}});
+
+    size_t found = 0;
+    while (!frontier.empty() && found < k) {
+        PathState state = frontier.top();
+        frontier.pop();
+        expanded += 1;
+
+        SymbolUID node = state.path.back();
+        if (node == end) {
+            if (!callback(state.path)) {
+                return;
+            }
+            ++found;
+            continue;
+        }
+
+        auto [callee_it, callee_end] = graph_.csr_callees(node);
+        for (; callee_it != callee_end; ++callee_it) {
+            SymbolUID callee = *callee_it;
+
+            // Prune nodes that cannot reach end and cycles within this path
+            auto dist_it = dist_to_end.find(callee);
+            if (dist_it == dist_to_end.end()) {
+                continue;
+            }
+            if (std::find(state.path.begin(), state.path.end(), callee) != state.path.end()) {
+                continue;
+            }
+
+            // Hub (--exclude-hubs) and scope (--scope) pruning; the target
+            // itself is exempt
+            if (callee != end && (skip_hub(callee) || out_of_scope(callee))) {
+                continue;
+            }
+
+            PathState next;
+            next.path = state.path;
+            next.path.push_back(callee);
+            next.estimate = static_cast<uint32_t>(next.path.size() - 1) + dist_it->second;
+            frontier.push(std::move(next));
+        }
+    }
+}
+
+bool QueryEngine::is_reachable(const std::string &start, const std::string &end) const {
+    SymbolUID start_uid = graph_.get_uid(start);
+    SymbolUID end_uid = graph_.get_uid(end);
+    if (start_uid == INVALID_UID || end_uid == INVALID_UID) {
+        return false;
+    }
+
+    const SccCondensation &scc = graph_.call_graph.condensation();
+    return reachable_from(scc.scc_of[start_uid])[scc.scc_of[end_uid]] != 0;
+}
+
+const std::vector<uint8_t> &QueryEngine::reachable_from(uint32_t source_scc) const {
+    auto it = reach_cache_.find(source_scc);
+    if (it != reach_cache_.end()) {
+        return it->second;
+    }
+
+    // Crude bound on cache growth; a sweep rarely uses more than a handful
+    // of distinct start symbols
+    if (reach_cache_.size() >= 64) {
+        reach_cache_.clear();
+    }
+
+    const SccCondensation &scc = graph_.call_graph.condensation();
+    std::vector<uint8_t> reachable = bfs_closure(scc.dag, source_scc, scc.count);
+
+    return reach_cache_.emplace(source_scc, std::move(reachable)).first->second;
+}
+
 std::vector<std::string> QueryEngine::immediate_callers(const std::string &symbol) const {
     std::vector<std::string> callers;
 
@@ -507,7 +982,7 @@ std::vector<std::string> QueryEngine::variables_in(const std::string &func_patte
         if (!graph_.is_variable(uid))
             continue;
 
-        if (symbol.find(func_pattern) != std::string::npos) {
+        if (simd::contains(symbol, func_pattern)) {
             vars.push_back(symbol);
         }
     }
@@ -534,12 +1009,12 @@ void QueryEngine::find_data_flow_paths(const std::string &source, const std::str
     dfs_data_flow(src_uid, var_uid, callback);
 }
 
-// Optimized data flow DFS using iterators instead of copying sink vectors
+// Optimized data flow DFS over the packed CSR data-flow adjacency
 void QueryEngine::dfs_data_flow(SymbolUID source, SymbolUID target, PathCallback &callback) {
     struct State {
         SymbolUID node;
-        std::unordered_set<SymbolUID>::const_iterator current_it;
-        std::unordered_set<SymbolUID>::const_iterator end_it;
+        const SymbolUID *current_it;
+        const SymbolUID *end_it;
     };
 
     std::vector<State> stack;
@@ -551,8 +1026,8 @@ void QueryEngine::dfs_data_flow(SymbolUID source, SymbolUID target, PathCallback
     std::unordered_set<SymbolUID> in_path;
     in_path.reserve(128);
 
-    const auto &init_sinks = graph_.get_data_sinks(source);
-    stack.push_back({source, init_sinks.begin(), init_sinks.end()});
+    auto [init_begin, init_end] = graph_.csr_data_sinks(source);
+    stack.push_back({source, init_begin, init_end});
     current_path.push_back(source);
     in_path.insert(source);
 
@@ -589,9 +1064,9 @@ void QueryEngine::dfs_data_flow(SymbolUID source, SymbolUID target, PathCallback
                 continue;
             }
 
-            // Push new state with iterators
-            const auto &next_sinks = graph_.get_data_sinks(sink);
-            stack.push_back({sink, next_sinks.begin(), next_sinks.end()});
+            // Push new state with pointers into the sink's CSR slice
+            auto [next_begin, next_end] = graph_.csr_data_sinks(sink);
+            stack.push_back({sink, next_begin, next_end});
             current_path.push_back(sink);
             in_path.insert(sink);
             found_next = true;
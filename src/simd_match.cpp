@@ -0,0 +1,152 @@
+// Copyright 2025 Siddhant Biradar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pioneer/simd_match.hpp"
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define PIONEER_SIMD_X86 1
+#endif
+
+namespace pioneer {
+namespace simd {
+
+namespace {
+
+// All kernels are called with needle.size() >= 2 and
+// haystack.size() >= needle.size(); the trivial cases are peeled off in
+// contains() so each kernel only handles the general shape.
+
+#ifndef PIONEER_SIMD_X86
+
+bool contains_scalar(std::string_view haystack, std::string_view needle) {
+    return haystack.find(needle) != std::string_view::npos;
+}
+
+#else
+
+// First/last-byte filter: compare one register of haystack against the
+// broadcast first needle byte and, shifted by needle.size() - 1, against the
+// broadcast last byte. Only positions where both hit can start a match, so
+// the (comparatively expensive) middle memcmp runs on a handful of
+// candidates per register instead of every offset. Unaligned loads stay in
+// bounds because the last-byte load at offset i reads through
+// haystack[i + 31 + needle.size() - 1] <= haystack[size - 1].
+
+__attribute__((target("avx2"))) bool contains_avx2(std::string_view haystack,
+                                                   std::string_view needle) {
+    const char *hay = haystack.data();
+    const size_t n_len = needle.size();
+    const size_t last_start = haystack.size() - n_len; // last valid match offset
+    const __m256i first = _mm256_set1_epi8(needle.front());
+    const __m256i last = _mm256_set1_epi8(needle.back());
+
+    size_t i = 0;
+    for (; i + 32 <= last_start + 1; i += 32) {
+        __m256i block_first =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(hay + i));
+        __m256i block_last =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(hay + i + n_len - 1));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last))));
+        while (mask != 0) {
+            unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+            mask &= mask - 1;
+            if (std::memcmp(hay + i + bit + 1, needle.data() + 1, n_len - 2) == 0) {
+                return true;
+            }
+        }
+    }
+
+    for (; i <= last_start; ++i) {
+        if (hay[i] == needle.front() &&
+            std::memcmp(hay + i + 1, needle.data() + 1, n_len - 1) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// SSE2 is part of the x86-64 baseline, so this variant needs no target
+// attribute and serves as the floor on any x86-64 machine.
+bool contains_sse2(std::string_view haystack, std::string_view needle) {
+    const char *hay = haystack.data();
+    const size_t n_len = needle.size();
+    const size_t last_start = haystack.size() - n_len;
+    const __m128i first = _mm_set1_epi8(needle.front());
+    const __m128i last = _mm_set1_epi8(needle.back());
+
+    size_t i = 0;
+    for (; i + 16 <= last_start + 1; i += 16) {
+        __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hay + i));
+        __m128i block_last =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(hay + i + n_len - 1));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last))));
+        while (mask != 0) {
+            unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+            mask &= mask - 1;
+            if (std::memcmp(hay + i + bit + 1, needle.data() + 1, n_len - 2) == 0) {
+                return true;
+            }
+        }
+    }
+
+    for (; i <= last_start; ++i) {
+        if (hay[i] == needle.front() &&
+            std::memcmp(hay + i + 1, needle.data() + 1, n_len - 1) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif // PIONEER_SIMD_X86
+
+using ContainsFn = bool (*)(std::string_view, std::string_view);
+
+ContainsFn resolve_contains() {
+#ifdef PIONEER_SIMD_X86
+    if (__builtin_cpu_supports("avx2")) {
+        return contains_avx2;
+    }
+    return contains_sse2;
+#else
+    return contains_scalar;
+#endif
+}
+
+// Resolved once at static-init time; every call after that is a plain
+// indirect call with no per-call CPUID cost.
+const ContainsFn g_contains = resolve_contains();
+
+} // namespace
+
+bool contains(std::string_view haystack, std::string_view needle) {
+    if (needle.empty()) {
+        return true;
+    }
+    if (haystack.size() < needle.size()) {
+        return false;
+    }
+    if (needle.size() == 1) {
+        return std::memchr(haystack.data(), needle.front(), haystack.size()) != nullptr;
+    }
+    return g_contains(haystack, needle);
+}
+
+} // namespace simd
+} // namespace pioneer
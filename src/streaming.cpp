@@ -12,7 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "pioneer/simd_match.hpp"
 #include "pioneer/streaming.hpp"
+#include "pioneer/zstd_stream.hpp"
 #include <fstream>
 #include <stdexcept>
 
@@ -69,7 +71,7 @@ bool StreamingSearchHandler::key(string_t &key) {
     } else if (in_uids && depth == 3) {
         // key is a symbol name - check if it matches any pattern
         for (const auto &pattern : patterns) {
-            if (key.find(pattern) != std::string::npos) {
+            if (simd::contains(key, pattern)) {
                 matches.push_back(key);
                 break;
             }
@@ -153,16 +155,109 @@ bool StreamingFilePathHandler::parse_error(std::size_t, const std::string &,
     return false;
 }
 
+bool StreamingMetadataHandler::append(nlohmann::json &&val) {
+    if (in_metadata && !stack.empty()) {
+        nlohmann::json *top = stack.back();
+        if (top->is_array()) {
+            top->push_back(std::move(val));
+        } else {
+            (*top)[current_key] = std::move(val);
+        }
+    }
+    return true;
+}
+
+nlohmann::json *StreamingMetadataHandler::push_container(nlohmann::json &&container) {
+    nlohmann::json *top = stack.back();
+    if (top->is_array()) {
+        top->push_back(std::move(container));
+        return &top->back();
+    }
+    (*top)[current_key] = std::move(container);
+    return &(*top)[current_key];
+}
+
+bool StreamingMetadataHandler::null() { return append(nullptr); }
+bool StreamingMetadataHandler::boolean(bool val) { return append(val); }
+bool StreamingMetadataHandler::number_integer(number_integer_t val) { return append(val); }
+bool StreamingMetadataHandler::number_unsigned(number_unsigned_t val) { return append(val); }
+bool StreamingMetadataHandler::number_float(number_float_t val, const string_t &) {
+    return append(val);
+}
+bool StreamingMetadataHandler::string(string_t &val) { return append(val); }
+bool StreamingMetadataHandler::binary(binary_t &) { return true; }
+
+bool StreamingMetadataHandler::start_object(std::size_t) {
+    depth++;
+    if (in_metadata) {
+        if (depth == 2) {
+            stack.push_back(&metadata);
+        } else if (!stack.empty()) {
+            stack.push_back(push_container(nlohmann::json::object()));
+        }
+    }
+    return true;
+}
+
+bool StreamingMetadataHandler::end_object() {
+    depth--;
+    if (in_metadata && !stack.empty()) {
+        stack.pop_back();
+        if (stack.empty()) {
+            done = true; // Closed the metadata object - we're done!
+            return false;
+        }
+    }
+    return true;
+}
+
+bool StreamingMetadataHandler::start_array(std::size_t) {
+    if (in_metadata && !stack.empty()) {
+        stack.push_back(push_container(nlohmann::json::array()));
+    }
+    return true;
+}
+
+bool StreamingMetadataHandler::end_array() {
+    if (in_metadata && !stack.empty()) {
+        stack.pop_back();
+    }
+    return true;
+}
+
+bool StreamingMetadataHandler::key(string_t &key) {
+    current_key = key;
+    if (depth == 1 && key == "metadata") {
+        in_metadata = true;
+    } else if (in_metadata && depth == 2 && key == "UIDs") {
+        // Everything before the UIDs table is the header; stop before the
+        // bulk of the document is decompressed
+        done = true;
+        return false;
+    }
+    return true;
+}
+
+bool StreamingMetadataHandler::parse_error(std::size_t, const std::string &,
+                                           const nlohmann::json::exception &) {
+    return false;
+}
+
 std::vector<std::string> stream_search_symbols(const std::string &index_file,
                                                const std::vector<std::string> &patterns) {
-    std::ifstream file(index_file);
+    std::ifstream file(index_file, std::ios::in | std::ios::binary);
     if (!file.is_open()) {
         throw std::runtime_error("Cannot open index file: " + index_file);
     }
 
     std::vector<std::string> matches;
     StreamingSearchHandler handler(patterns, matches);
-    nlohmann::json::sax_parse(file, &handler);
+    if (stream_is_zstd(file)) {
+        ZstdIstream zin(file);
+        nlohmann::json::sax_parse(zin, &handler);
+    } else {
+        nlohmann::json::sax_parse(file, &handler);
+    }
     return matches;
 }
 
@@ -172,15 +267,39 @@ std::vector<std::string> stream_all_symbols(const std::string &index_file) {
 }
 
 std::vector<std::string> stream_file_paths(const std::string &index_file) {
-    std::ifstream file(index_file);
+    std::ifstream file(index_file, std::ios::in | std::ios::binary);
     if (!file.is_open()) {
         throw std::runtime_error("Cannot open index file: " + index_file);
     }
 
     std::vector<std::string> paths;
     StreamingFilePathHandler handler(paths);
-    nlohmann::json::sax_parse(file, &handler);
+    if (stream_is_zstd(file)) {
+        ZstdIstream zin(file);
+        nlohmann::json::sax_parse(zin, &handler);
+    } else {
+        nlohmann::json::sax_parse(file, &handler);
+    }
     return paths;
 }
 
+nlohmann::json stream_index_metadata(const std::string &index_file) {
+    std::ifstream file(index_file, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open index file: " + index_file);
+    }
+
+    StreamingMetadataHandler handler;
+    if (stream_is_zstd(file)) {
+        ZstdIstream zin(file);
+        nlohmann::json::sax_parse(zin, &handler);
+    } else {
+        nlohmann::json::sax_parse(file, &handler);
+    }
+    if (!handler.done) {
+        throw std::runtime_error("No metadata header found in index: " + index_file);
+    }
+    return std::move(handler.metadata);
+}
+
 } // namespace pioneer
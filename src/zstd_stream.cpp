@@ -0,0 +1,153 @@
+// Copyright 2025 Siddhant Biradar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pioneer/zstd_stream.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <zstd.h>
+
+namespace pioneer {
+
+namespace {
+
+// Close a frame after this much uncompressed input so readers can decode
+// the file as independent sections
+constexpr size_t FRAME_TARGET = 32 * 1024 * 1024;
+
+// Staging buffer for uncompressed data on both paths
+constexpr size_t STAGE_SIZE = 1 * 1024 * 1024;
+
+constexpr unsigned char ZSTD_FRAME_MAGIC[4] = {0x28, 0xB5, 0x2F, 0xFD};
+
+} // namespace
+
+bool stream_is_zstd(std::istream &in) {
+    char head[4] = {};
+    in.read(head, sizeof(head));
+    bool complete = in.gcount() == sizeof(head);
+    in.clear();
+    in.seekg(0);
+    return complete && std::memcmp(head, ZSTD_FRAME_MAGIC, sizeof(head)) == 0;
+}
+
+ZstdOutBuf::ZstdOutBuf(std::ostream &sink)
+    : sink_(sink), in_buf_(STAGE_SIZE), out_buf_(ZSTD_CStreamOutSize()) {
+    cctx_ = ZSTD_createCCtx();
+    if (!cctx_) {
+        throw std::runtime_error("Failed to create zstd compression context");
+    }
+    setp(in_buf_.data(), in_buf_.data() + in_buf_.size());
+}
+
+ZstdOutBuf::~ZstdOutBuf() {
+    try {
+        finish();
+    } catch (...) {
+        // Best effort on teardown; an incomplete frame is detected on load
+    }
+    ZSTD_freeCCtx(cctx_);
+}
+
+void ZstdOutBuf::compress_pending(bool end_frame) {
+    ZSTD_inBuffer input{pbase(), static_cast<size_t>(pptr() - pbase()), 0};
+    frame_bytes_ += input.size;
+
+    bool close_frame = end_frame || frame_bytes_ >= FRAME_TARGET;
+    ZSTD_EndDirective directive = close_frame ? ZSTD_e_end : ZSTD_e_continue;
+
+    for (;;) {
+        ZSTD_outBuffer output{out_buf_.data(), out_buf_.size(), 0};
+        size_t remaining = ZSTD_compressStream2(cctx_, &output, &input, directive);
+        if (ZSTD_isError(remaining)) {
+            throw std::runtime_error(std::string("zstd compression failed: ") +
+                                     ZSTD_getErrorName(remaining));
+        }
+        sink_.write(out_buf_.data(), static_cast<std::streamsize>(output.pos));
+        if (close_frame ? remaining == 0 : input.pos == input.size) {
+            break;
+        }
+    }
+
+    if (close_frame) {
+        frame_bytes_ = 0;
+    }
+    setp(in_buf_.data(), in_buf_.data() + in_buf_.size());
+}
+
+int ZstdOutBuf::overflow(int ch) {
+    compress_pending(false);
+    if (ch != traits_type::eof()) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return ch;
+}
+
+int ZstdOutBuf::sync() {
+    compress_pending(false);
+    sink_.flush();
+    return sink_ ? 0 : -1;
+}
+
+void ZstdOutBuf::finish() {
+    if (finished_) {
+        return;
+    }
+    finished_ = true;
+    compress_pending(true);
+    sink_.flush();
+}
+
+ZstdInBuf::ZstdInBuf(std::istream &source)
+    : source_(source), in_buf_(ZSTD_DStreamInSize()), out_buf_(ZSTD_DStreamOutSize()) {
+    dctx_ = ZSTD_createDCtx();
+    if (!dctx_) {
+        throw std::runtime_error("Failed to create zstd decompression context");
+    }
+}
+
+ZstdInBuf::~ZstdInBuf() { ZSTD_freeDCtx(dctx_); }
+
+int ZstdInBuf::underflow() {
+    if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    for (;;) {
+        if (in_pos_ == in_size_) {
+            source_.read(in_buf_.data(), static_cast<std::streamsize>(in_buf_.size()));
+            in_size_ = static_cast<size_t>(source_.gcount());
+            in_pos_ = 0;
+            if (in_size_ == 0) {
+                return traits_type::eof();
+            }
+        }
+
+        ZSTD_inBuffer input{in_buf_.data(), in_size_, in_pos_};
+        ZSTD_outBuffer output{out_buf_.data(), out_buf_.size(), 0};
+        size_t ret = ZSTD_decompressStream(dctx_, &output, &input);
+        if (ZSTD_isError(ret)) {
+            throw std::runtime_error(std::string("zstd decompression failed: ") +
+                                     ZSTD_getErrorName(ret));
+        }
+        in_pos_ = input.pos;
+
+        if (output.pos > 0) {
+            setg(out_buf_.data(), out_buf_.data(), out_buf_.data() + output.pos);
+            return traits_type::to_int_type(*gptr());
+        }
+    }
+}
+
+} // namespace pioneer